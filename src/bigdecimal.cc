@@ -0,0 +1,259 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "bigdecimal.hh"
+
+namespace extypes {
+
+namespace {
+const unsigned pow10[] = {1,      10,      100,      1000,     10000,
+                          100000, 1000000, 10000000, 100000000};
+}
+
+bigdecimal::bigdecimal() : u(0), s(0) {}
+bigdecimal::bigdecimal(int a) : u(a), s(0) {}
+bigdecimal::bigdecimal(long a) : u(a), s(0) {}
+bigdecimal::bigdecimal(long long a) : u(a), s(0) {}
+bigdecimal::bigdecimal(const bigint &a, long b) : u(a), s(b) {}
+bigdecimal::bigdecimal(const std::string &a) : u(0), s(0) {
+    // Digits go straight into limbs, nine at a time from the right.
+    std::string::size_type begin = 0, point = std::string::npos;
+    bool p = true;
+    if (!a.empty() && (a.at(0) == '+' || a.at(0) == '-')) {
+        p = a.at(0) == '+';
+        begin = 1;
+    }
+    std::string::size_type ndigits = 0;
+    for (auto i = begin; i < a.length(); ++i) {
+        if (a.at(i) == '.' && point == std::string::npos) point = i;
+        else if (isdigit(a.at(i)))
+            ++ndigits;
+        else
+            throw std::invalid_argument("Invalid argument.");
+    }
+    if (ndigits == 0) throw std::invalid_argument("Invalid argument.");
+    if (point != std::string::npos) s = long(a.length() - point - 1);
+
+    auto &num = u.num;
+    num.assign((ndigits + bigint::base_len - 2) / (bigint::base_len - 1), 0);
+    std::string::size_type k = 0;
+    for (auto i = a.length(); i-- > begin;) {
+        if (a.at(i) == '.') continue;
+        num.at(k / (bigint::base_len - 1)) +=
+            (a.at(i) - '0') * pow10[k % (bigint::base_len - 1)];
+        ++k;
+    }
+    u.trim();
+    u.pos = p || u.is_zero();
+}
+bigdecimal::bigdecimal(const bigdecimal &a) : u(a.u), s(a.s) {}
+
+const bigint &bigdecimal::unscaled() const { return u; }
+long bigdecimal::scale() const { return s; }
+bool bigdecimal::sign() const { return u.sign(); }
+bigdecimal bigdecimal::rescale(long a, rounding m) const {
+    bigdecimal t(*this);
+    if (a > s) scale_up(t.u, a - s);
+    else if (a < s)
+        scale_down(t.u, s - a, m);
+    t.s = a;
+    return t;
+}
+
+std::string bigdecimal::to_string() const {
+    std::string r = u.abs().to_string();
+    if (s < 0 && !u.is_zero()) r.append(-s, '0');
+    if (s > 0) {
+        if (r.length() <= (unsigned long)s)
+            r.insert(0, s - r.length() + 1, '0');
+        r.insert(r.length() - s, 1, '.');
+    }
+    if (!u.sign() && !u.is_zero()) r.insert(0, 1, '-');
+    return r;
+}
+std::ostream &operator<<(std::ostream &os, const bigdecimal &a) {
+    return os << a.to_string();
+}
+
+bigdecimal bigdecimal::operator+() const { return *this; }
+bigdecimal bigdecimal::operator-() const { return bigdecimal(-u, s); }
+
+bigdecimal &bigdecimal::operator+=(const bigdecimal &a) {
+    if (s == a.s) {
+        u += a.u;
+    } else if (s > a.s) {
+        thread_local bigint t;
+        t = a.u;
+        scale_up(t, s - a.s);
+        u += t;
+    } else {
+        scale_up(u, a.s - s);
+        s = a.s;
+        u += a.u;
+    }
+    return *this;
+}
+bigdecimal &bigdecimal::operator-=(const bigdecimal &a) {
+    if (s == a.s) {
+        u -= a.u;
+    } else if (s > a.s) {
+        thread_local bigint t;
+        t = a.u;
+        scale_up(t, s - a.s);
+        u -= t;
+    } else {
+        scale_up(u, a.s - s);
+        s = a.s;
+        u -= a.u;
+    }
+    return *this;
+}
+bigdecimal &bigdecimal::operator*=(const bigdecimal &a) {
+    u *= a.u;
+    s += a.s;
+    return *this;
+}
+
+bigdecimal bigdecimal::operator+(const bigdecimal &a) const {
+    bigdecimal t(*this);
+    return t += a;
+}
+bigdecimal bigdecimal::operator-(const bigdecimal &a) const {
+    bigdecimal t(*this);
+    return t -= a;
+}
+bigdecimal bigdecimal::operator*(const bigdecimal &a) const {
+    bigdecimal t(*this);
+    return t *= a;
+}
+
+bigdecimal &bigdecimal::operator=(const bigdecimal &a) {
+    u = a.u;
+    s = a.s;
+    return *this;
+}
+
+bigdecimal div(const bigdecimal &a, const bigdecimal &b, long scale,
+               rounding m) {
+    return bigdecimal::quotient(a, b, scale, m);
+}
+
+int bigdecimal::compare(const bigdecimal &a) const {
+    int sg = u.is_zero() ? 0 : u.sign() ? 1 : -1;
+    int asg = a.u.is_zero() ? 0 : a.u.sign() ? 1 : -1;
+    if (sg != asg || sg == 0 || s == a.s)
+        return sg != asg ? (sg < asg ? -1 : 1) : u.compare(a.u);
+    thread_local bigint t;
+    if (s < a.s) {
+        t = u;
+        scale_up(t, a.s - s);
+        return t.compare(a.u);
+    }
+    t = a.u;
+    scale_up(t, s - a.s);
+    return u.compare(t);
+}
+bool bigdecimal::operator==(const bigdecimal &a) const {
+    return compare(a) == 0;
+}
+bool bigdecimal::operator!=(const bigdecimal &a) const {
+    return compare(a) != 0;
+}
+bool bigdecimal::operator<(const bigdecimal &a) const {
+    return compare(a) < 0;
+}
+bool bigdecimal::operator>(const bigdecimal &a) const {
+    return compare(a) > 0;
+}
+bool bigdecimal::operator<=(const bigdecimal &a) const {
+    return compare(a) <= 0;
+}
+bool bigdecimal::operator>=(const bigdecimal &a) const {
+    return compare(a) >= 0;
+}
+
+bigdecimal bigdecimal::quotient(const bigdecimal &a, const bigdecimal &b,
+                                long scale, rounding m) {
+    if (b.u.is_zero()) throw std::runtime_error("Division by zero");
+    // a / b * 10^scale = (a.u * 10^e) / b.u with e = scale - a.s + b.s.
+    bigint n(a.u), d(b.u);
+    long e = scale - a.s + b.s;
+    if (e > 0) scale_up(n, e);
+    else if (e < 0)
+        scale_up(d, -e);
+    bool neg = a.u.sign() != b.u.sign() && !a.u.is_zero();
+    bigint q, r;
+    divmod(q, r, n, d);
+    r.mul_small(2);
+    int half = bigint::compare_abs(r.num, d.num);
+    round_away(q, neg, half, r.is_zero(), m);
+    return bigdecimal(q, scale);
+}
+
+void bigdecimal::scale_up(bigint &a, unsigned long k) {
+    if (a.is_zero()) return;
+    a.num.insert(a.num.begin(), k / (bigint::base_len - 1), 0);
+    a.mul_small(pow10[k % (bigint::base_len - 1)]);
+}
+void bigdecimal::scale_down(bigint &a, unsigned long k, rounding m) {
+    // The dropped part is compared with half of 10^k through its leading
+    // digit (digit k - 1) and whether any digit below it is non-zero.
+    const unsigned long w = bigint::base_len - 1;
+    bool neg = !a.sign() && !a.is_zero();
+    auto li = (k - 1) / w, di = (k - 1) % w;
+    unsigned lead = 0;
+    bool rest = false;
+    if (li < a.num.size()) {
+        lead = a.num.at(li) / pow10[di] % 10;
+        rest = a.num.at(li) % pow10[di] != 0;
+    }
+    for (std::size_t i = 0; i < li && i < a.num.size() && !rest; ++i)
+        rest = a.num.at(i) != 0;
+
+    auto drop = std::min<std::size_t>(k / w, a.num.size());
+    a.num.erase(a.num.begin(), a.num.begin() + drop);
+    if (a.num.empty()) a.num.push_back(0);
+    else if (k % w != 0)
+        a.divmod_small(pow10[k % w]);
+    int half = lead > 5 || (lead == 5 && rest) ? 1 : lead == 5 ? 0 : -1;
+    round_away(a, neg, half, lead == 0 && !rest, m);
+}
+void bigdecimal::round_away(bigint &q, bool neg, int half, bool exact,
+                            rounding m) {
+    bool away = false;
+    switch (m) {
+        case rounding::down: break;
+        case rounding::up: away = !exact; break;
+        case rounding::floor: away = !exact && neg; break;
+        case rounding::ceiling: away = !exact && !neg; break;
+        case rounding::half_down: away = half > 0; break;
+        case rounding::half_up: away = half >= 0 && !exact; break;
+        case rounding::half_even:
+            away = half > 0 || (half == 0 && !exact && (q.num.at(0) & 1));
+            break;
+    }
+    q.pos = true;
+    if (away) q += 1;
+    q.pos = !neg || q.is_zero();
+}
+
+}  // namespace extypes
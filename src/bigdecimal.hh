@@ -0,0 +1,93 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <iostream>
+#include <string>
+
+#include "bigint.hh"
+
+namespace extypes {
+enum class rounding { down, up, floor, ceiling, half_down, half_up, half_even };
+
+// Fixed-point decimal: unscaled() * 10^-scale().
+//
+// bigint keeps base-10^9 limbs, so changing the scale by 9k digits moves
+// whole limbs and the remaining k < 9 digits take one single-limb pass;
+// rescaling and rounding never run a full multiplication or division.
+struct bigdecimal {
+    bigdecimal();
+    bigdecimal(int);
+    bigdecimal(long);
+    bigdecimal(long long);
+    bigdecimal(const bigint &, long scale = 0);
+    explicit bigdecimal(const std::string &);
+    bigdecimal(const bigdecimal &);
+
+    const bigint &unscaled() const;
+    long scale() const;
+    bool sign() const;
+    bigdecimal rescale(long, rounding = rounding::half_even) const;
+
+    std::string to_string() const;
+    friend std::ostream &operator<<(std::ostream &, const bigdecimal &);
+
+    bigdecimal operator+() const;
+    bigdecimal operator-() const;
+
+    bigdecimal &operator+=(const bigdecimal &);
+    bigdecimal &operator-=(const bigdecimal &);
+    bigdecimal &operator*=(const bigdecimal &);
+
+    bigdecimal operator+(const bigdecimal &) const;
+    bigdecimal operator-(const bigdecimal &) const;
+    bigdecimal operator*(const bigdecimal &) const;
+
+    bigdecimal &operator=(const bigdecimal &);
+
+    // Quotient rounded to the given scale.
+    friend bigdecimal div(const bigdecimal &, const bigdecimal &, long,
+                          rounding);
+
+    int compare(const bigdecimal &) const;
+    bool operator==(const bigdecimal &) const;
+    bool operator!=(const bigdecimal &) const;
+    bool operator<(const bigdecimal &) const;
+    bool operator>(const bigdecimal &) const;
+    bool operator<=(const bigdecimal &) const;
+    bool operator>=(const bigdecimal &) const;
+
+  private:
+    bigint u;
+    long s;
+
+    static bigdecimal quotient(const bigdecimal &, const bigdecimal &, long,
+                               rounding);
+    static void scale_up(bigint &, unsigned long);
+    static void scale_down(bigint &, unsigned long, rounding);
+    static void round_away(bigint &, bool, int, bool, rounding);
+};
+
+bigdecimal div(const bigdecimal &, const bigdecimal &, long,
+               rounding = rounding::half_even);
+}  // namespace extypes
@@ -22,15 +22,21 @@
 
 #include "bigint.hh"
 
+#include <bitset>
+#include <cstdio>
+#include <cstring>
+
+#include "power_cache.hh"
+
 namespace extypes {
 
 bigint::bigint() : pos(true) {}
 bigint::bigint(int n) : pos(n >= 0) {
-    n = std::abs(n);
-    if (n == 0) num.push_back(0);
-    while (n != 0) {
-        num.push_back(n % base);
-        n /= base;
+    auto m = magnitude(n);
+    if (m == 0) num.push_back(0);
+    while (m != 0) {
+        num.push_back(m % base);
+        m /= base;
     }
 }
 bigint::bigint(unsigned n, bool p) : pos(p) {
@@ -41,11 +47,11 @@ bigint::bigint(unsigned n, bool p) : pos(p) {
     }
 }
 bigint::bigint(long n) : pos(n >= 0) {
-    n = std::abs(n);
-    if (n == 0) num.push_back(0);
-    while (n != 0) {
-        num.push_back(n % base);
-        n /= base;
+    auto m = magnitude(n);
+    if (m == 0) num.push_back(0);
+    while (m != 0) {
+        num.push_back(m % base);
+        m /= base;
     }
 }
 bigint::bigint(unsigned long n, bool p) : pos(p) {
@@ -56,41 +62,58 @@ bigint::bigint(unsigned long n, bool p) : pos(p) {
     }
 }
 bigint::bigint(long long n) : pos(n >= 0) {
-    n = std::abs(n);
+    auto m = magnitude(n);
+    if (m == 0) num.push_back(0);
+    while (m != 0) {
+        num.push_back(m % base);
+        m /= base;
+    }
+}
+#ifdef __SIZEOF_INT128__
+bigint::bigint(int128 n)
+    : bigint(n < 0 ? uint128(0) - uint128(n) : uint128(n), n >= 0) {}
+bigint::bigint(uint128 n, bool p) : pos(p) {
     if (n == 0) num.push_back(0);
     while (n != 0) {
-        num.push_back(n % base);
+        num.push_back(unsigned(n % base));
         n /= base;
     }
 }
-bigint::bigint(std::vector<unsigned> a, bool p) : num(a), pos(p) {}
+#endif
+bigint bigint::from_double(double d) {
+    if (!std::isfinite(d)) throw std::invalid_argument("Invalid argument.");
+    d = std::trunc(d);
+    if (std::fabs(d) < 9.2e18) return bigint((long long)d);
+    // |d| >= 2^63, so d = m * 2^(e - 53) with a 53-bit m and e - 53 > 0.
+    int e;
+    auto m = (long long)std::ldexp(std::frexp(std::fabs(d), &e), 53);
+    return bigint(d > 0 ? m : -m) << (e - 53);
+}
+bigint::bigint(std::vector<unsigned> a, bool p) : num(std::move(a)), pos(p) {}
 bigint::bigint(std::string a) {
     pos = true;
     if (a.length() == 0) return;
 
-    if (a.at(0) == '+' || a.at(0) == '-') {
-        pos = (a.at(0) == '+');
-        a.erase(a.begin());
-    }
-    if (!std::all_of(a.begin(), a.end(), isdigit))
+    std::size_t s = 0;
+    if (a.at(0) == '+' || a.at(0) == '-') pos = (a.at(s++) == '+');
+    if (!std::all_of(a.begin() + s, a.end(), isdigit))
         throw std::invalid_argument("Invalid argument.");
-
-    std::vector<std::string> t;
-
-    auto oa_len = a.length();
-    for (unsigned long i = 0; i < oa_len / (base_len - 1); ++i) {
-        t.push_back(a.substr(a.length() - base_len + 1));
-        a.erase(a.end() - base_len + 1, a.end());
-    }
-    std::for_each(t.begin(), t.end(),
-                  [&](const auto &e) { num.push_back(std::stoi(e)); });
-    if (a.length() % (base_len - 1) != 0) num.push_back(std::stoi(a));
+    auto n = a.length() - s;
+    num.resize((n + base_len - 2) / (base_len - 1));
+    parse_limbs(a.data() + s, n, num.data(), 0, num.size());
+    if (!num.empty()) trim();
 }
 bigint::bigint(const bigint &a) : num(a.num), pos(a.pos) {}
+bigint::bigint(bigint &&a) noexcept : num(std::move(a.num)), pos(a.pos) {}
 
 bool bigint::sign() const { return pos; }
-bigint bigint::abs() const { return bigint(num, true); }
+bigint bigint::abs() const & { return bigint(num, true); }
+bigint bigint::abs() && {
+    pos = true;
+    return std::move(*this);
+}
 bigint bigint::fact() const {
+    if (auto n = try_convert<int>()) return *n < 0 ? bigint(1) : factorial(*n);
     bigint r = 1;
     for (bigint i = 1; i <= *this; ++i) {
         r *= i;
@@ -100,6 +123,30 @@ bigint bigint::fact() const {
 std::string::size_type bigint::digits() const {
     return (*this).to_string().length() - (pos ? 0 : 1);
 }
+std::size_t bigint::bit_length() const {
+    auto w = to_binary();
+    if (w.empty()) return 0;
+    std::size_t r = 32 * (w.size() - 1);
+    for (auto e = w.back(); e != 0; e >>= 1) ++r;
+    return r;
+}
+std::size_t bigint::popcount() const {
+    std::size_t r = 0;
+    for (const auto &e : to_binary()) r += std::bitset<32>(e).count();
+    return r;
+}
+bool bigint::test_bit(std::size_t a) const {
+    bigint t(*this);
+    return (t.rshift_a(a).num.at(0) & 1) != 0;
+}
+unsigned bigint::remainder(unsigned a) const {
+    if (num.empty()) throw std::runtime_error("remainder: Object is empty.");
+    if (a == 0) throw std::runtime_error("Division by zero");
+    unsigned long long r = 0;
+    for (auto it = num.rbegin(); it != num.rend(); ++it)
+        r = (r * base + *it) % a;
+    return unsigned(r);
+}
 
 std::string bigint::to_string() const {
     std::ostringstream ros;
@@ -113,48 +160,122 @@ std::string bigint::to_string() const {
     return ros.str();
 }
 std::ostream &operator<<(std::ostream &os, const bigint &a) {
-    return os << a.to_string();
+    // Padding needs the length up front, so it goes through to_string().
+    if (a.num.empty() || os.width() != 0) return os << a.to_string();
+    // Otherwise the limbs are formatted through a small buffer.
+    char buf[4096];
+    std::size_t n = a.limb_count(), len = 0;
+    if (!a.pos && !a.is_zero()) buf[len++] = '-';
+    len += std::snprintf(buf + len, 16, "%u", a.num.at(n - 1));
+    for (auto i = n - 1; i-- > 0;) {
+        if (len + bigint::base_len > sizeof buf) {
+            os.write(buf, len);
+            len = 0;
+        }
+        bigint::format_limb(a.num[i], buf + len);
+        len += bigint::base_len - 1;
+    }
+    return os.write(buf, len);
 }
 std::istream &operator>>(std::istream &is, bigint &a) {
     std::string b;
     is >> b;
-    a = b;
+    a = bigint(std::move(b));
     return is;
 }
 
+void bigint::parse_limbs(const char *d, std::size_t n, unsigned *limbs,
+                         std::size_t first, std::size_t last) {
+    const std::size_t w = base_len - 1;
+    for (auto i = first; i < last; ++i) {
+        auto end = n - w * i, begin = end > w ? end - w : 0;
+        unsigned e = 0;
+        for (auto k = begin; k < end; ++k) e = e * 10 + unsigned(d[k] - '0');
+        limbs[i] = e;
+    }
+}
+void bigint::format_limb(unsigned e, char *out) {
+    for (auto k = base_len - 1; k-- > 0; e /= 10) out[k] = char('0' + e % 10);
+}
+
 bigint::operator int() const {
-    if (*this > INT_MAX || *this < INT_MIN)
-        throw std::out_of_range("Object is out of the range of Int.");
     int r = 0;
-    std::for_each(num.begin(), num.end(), [&](const auto &e) { r -= e; });
-    if (pos) r *= -1;
+    if (!convert_to(r))
+        throw std::out_of_range("Object is out of the range of Int.");
     return r;
 }
 bigint::operator unsigned() const {
-    if (*this > UINT_MAX || !pos)
-        throw std::out_of_range("Object is out of the range of Unsigned Int.");
     unsigned r = 0;
-    std::for_each(num.begin(), num.end(), [&](const auto &e) { r += e; });
+    if (!convert_to(r))
+        throw std::out_of_range("Object is out of the range of Unsigned Int.");
     return r;
 }
 bigint::operator long() const {
-    if (*this > LONG_MAX || *this < LONG_MIN)
-        throw std::out_of_range("Object is out of the range of Long.");
     long r = 0;
-    std::for_each(num.begin(), num.end(), [&](const auto &e) { r -= e; });
-    if (pos) r *= -1;
+    if (!convert_to(r))
+        throw std::out_of_range("Object is out of the range of Long.");
     return r;
 }
 bigint::operator unsigned long() const {
-    if (*this > ULONG_MAX || !pos)
-        throw std::out_of_range("Object is out of the range of Unsigned Long.");
     unsigned long r = 0;
-    std::for_each(num.begin(), num.end(), [&](const auto &e) { r += e; });
+    if (!convert_to(r))
+        throw std::out_of_range("Object is out of the range of Unsigned Long.");
     return r;
 }
-
-bigint bigint::operator+() const { return *this; }
-bigint bigint::operator-() const { return bigint(num, !pos); }
+#ifdef __SIZEOF_INT128__
+bigint::operator int128() const {
+    int128 r = 0;
+    if (!convert_to(r))
+        throw std::out_of_range("Object is out of the range of Int128.");
+    return r;
+}
+bigint::operator uint128() const {
+    uint128 r = 0;
+    if (!convert_to(r))
+        throw std::out_of_range(
+            "Object is out of the range of Unsigned Int128.");
+    return r;
+}
+#endif
+
+double bigint::to_double() const {
+    if (num.empty()) return std::numeric_limits<double>::quiet_NaN();
+    // 36 limbs are at least 10^315, past the largest double.
+    if (limb_count() >= 36) return pos ? HUGE_VAL : -HUGE_VAL;
+    long e;
+    double m = frexp(e);
+    return std::ldexp(m, int(e));
+}
+double bigint::frexp(long &e) const {
+    e = 0;
+    if (num.empty()) return std::numeric_limits<double>::quiet_NaN();
+    auto w = to_binary();
+    if (w.empty()) return 0;
+    std::size_t bits = 32 * (w.size() - 1);
+    for (auto t = w.back(); t != 0; t >>= 1) ++bits;
+    // The top 64 bits, with the lowest one set if any bit below them is:
+    // that bit is under the rounding position of a double, so converting
+    // rounds the same way as the full value would.
+    auto shift = bits > 64 ? bits - 64 : 0;
+    auto bit = [&](std::size_t i) { return (w[i / 32] >> (i % 32)) & 1; };
+    unsigned long long top = 0;
+    for (std::size_t i = 0; i < 64 && shift + i < bits; ++i)
+        top |= (unsigned long long)bit(shift + i) << i;
+    for (std::size_t i = 0; i < shift && !(top & 1); ++i) top |= bit(i);
+    int k;
+    double m = std::frexp(double(top), &k);
+    e = long(shift) + k;
+    return pos ? m : -m;
+}
+
+bigint bigint::operator+() const & { return *this; }
+bigint bigint::operator+() && { return std::move(*this); }
+bigint bigint::operator-() const & { return bigint(num, !pos); }
+bigint bigint::operator-() && {
+    pos = !pos;
+    return std::move(*this);
+}
+bigint bigint::operator~() const { return -*this - 1; }
 
 bigint &bigint::operator++() { return *this += 1; }
 bigint bigint::operator++(int) {
@@ -170,29 +291,15 @@ bigint bigint::operator--(int) {
 }
 
 unsigned bigint::operator[](int a) const { return num.at(a); }
+limb_span bigint::limbs() const {
+    return limb_span(num.data(), num.empty() ? 0 : limb_count());
+}
 
 bigint &bigint::operator+=(const bigint &a) {
     if (num.empty() || a.num.empty()) {
         throw std::runtime_error("Operator+=: Object is empty.");
     }
-
-    if (pos ^ a.pos) return *this -= -a;
-
-    bigint t(a);
-    short moveup = 0;
-    if (num.size() < a.num.size()) {
-        t = *this;
-        *this = a;
-        t.num.resize(num.size(), 0);
-    }
-
-    auto it_t = t.num.begin();
-    for (auto &e : num) {
-        e += (*it_t++) + moveup;
-        moveup = (e >= base) ? 1 : 0;
-        if (moveup) e -= base;
-    }
-    if (moveup) num.push_back(moveup);
+    add(*this, *this, a);
     return *this;
 }
 bigint &bigint::operator+=(int a) { return *this += bigint(a); }
@@ -205,31 +312,7 @@ bigint &bigint::operator-=(const bigint &a) {
     if (num.empty() || a.num.empty()) {
         throw std::runtime_error("Operator-=: Object is empty.");
     }
-
-    if (pos ^ a.pos) return *this += -a;
-
-    bigint t(a);
-    short moveup = 0;
-    bool rev_flag = false;
-    if ((*this).abs() < a.abs()) {
-        rev_flag = true;
-        t = *this;
-        *this = a;
-    }
-    if (num.size() > t.num.size()) t.num.resize(num.size(), 0);
-
-    auto it_t = t.num.begin();
-    for (auto &e : num) {
-        e += base - (*it_t++) + moveup;
-        if (e >= base) {
-            e -= base;
-            moveup = 0;
-        } else
-            moveup = -1;
-    }
-    if (num.at(num.size() - 1) == 0 && num.size() != 1) num.pop_back();
-
-    pos ^= rev_flag;
+    sub(*this, *this, a);
     return *this;
 }
 bigint &bigint::operator-=(int a) { return *this -= bigint(a); }
@@ -252,15 +335,79 @@ bigint &bigint::operator/=(int a) { return *this /= bigint(a); }
 bigint &bigint::operator/=(unsigned a) { return *this /= bigint(a); }
 bigint &bigint::operator/=(long a) { return *this /= bigint(a); }
 bigint &bigint::operator/=(unsigned long a) { return *this /= bigint(a); }
-bigint &bigint::operator/=(long long a) { return *this *= bigint(a); }
+bigint &bigint::operator/=(long long a) { return *this /= bigint(a); }
 
-bigint &bigint::operator%=(const bigint &a) { return *this -= a * (*this / a); }
+bigint &bigint::operator%=(const bigint &a) {
+    if (num.empty() || a.num.empty()) {
+        throw std::runtime_error("Operator%=: Object is empty.");
+    }
+    thread_local bigint q;
+    divmod(q, *this, *this, a);
+    return *this;
+}
 bigint &bigint::operator%=(int a) { return *this %= bigint(a); }
 bigint &bigint::operator%=(unsigned a) { return *this %= bigint(a); }
 bigint &bigint::operator%=(long a) { return *this %= bigint(a); }
 bigint &bigint::operator%=(unsigned long a) { return *this %= bigint(a); }
 bigint &bigint::operator%=(long long a) { return *this %= bigint(a); }
 
+bigint &bigint::operator<<=(int a) {
+    if (a < 0) throw std::invalid_argument("Negative shift count.");
+    return lshift_a(a);
+}
+bigint &bigint::operator<<=(unsigned a) { return lshift_a(a); }
+bigint &bigint::operator<<=(long a) {
+    if (a < 0) throw std::invalid_argument("Negative shift count.");
+    return lshift_a(a);
+}
+bigint &bigint::operator<<=(unsigned long a) { return lshift_a(a); }
+bigint &bigint::operator<<=(long long a) {
+    if (a < 0) throw std::invalid_argument("Negative shift count.");
+    return lshift_a(a);
+}
+
+bigint &bigint::operator>>=(int a) {
+    if (a < 0) throw std::invalid_argument("Negative shift count.");
+    return rshift_a(a);
+}
+bigint &bigint::operator>>=(unsigned a) { return rshift_a(a); }
+bigint &bigint::operator>>=(long a) {
+    if (a < 0) throw std::invalid_argument("Negative shift count.");
+    return rshift_a(a);
+}
+bigint &bigint::operator>>=(unsigned long a) { return rshift_a(a); }
+bigint &bigint::operator>>=(long long a) {
+    if (a < 0) throw std::invalid_argument("Negative shift count.");
+    return rshift_a(a);
+}
+
+bigint &bigint::operator&=(const bigint &a) {
+    return bitwise_a(a, std::bit_and<unsigned>());
+}
+bigint &bigint::operator&=(int a) { return *this &= bigint(a); }
+bigint &bigint::operator&=(unsigned a) { return *this &= bigint(a); }
+bigint &bigint::operator&=(long a) { return *this &= bigint(a); }
+bigint &bigint::operator&=(unsigned long a) { return *this &= bigint(a); }
+bigint &bigint::operator&=(long long a) { return *this &= bigint(a); }
+
+bigint &bigint::operator|=(const bigint &a) {
+    return bitwise_a(a, std::bit_or<unsigned>());
+}
+bigint &bigint::operator|=(int a) { return *this |= bigint(a); }
+bigint &bigint::operator|=(unsigned a) { return *this |= bigint(a); }
+bigint &bigint::operator|=(long a) { return *this |= bigint(a); }
+bigint &bigint::operator|=(unsigned long a) { return *this |= bigint(a); }
+bigint &bigint::operator|=(long long a) { return *this |= bigint(a); }
+
+bigint &bigint::operator^=(const bigint &a) {
+    return bitwise_a(a, std::bit_xor<unsigned>());
+}
+bigint &bigint::operator^=(int a) { return *this ^= bigint(a); }
+bigint &bigint::operator^=(unsigned a) { return *this ^= bigint(a); }
+bigint &bigint::operator^=(long a) { return *this ^= bigint(a); }
+bigint &bigint::operator^=(unsigned long a) { return *this ^= bigint(a); }
+bigint &bigint::operator^=(long long a) { return *this ^= bigint(a); }
+
 bigint bigint::operator+(const bigint &a) const {
     bigint t(*this);
     return t += a;
@@ -411,11 +558,148 @@ bigint operator%(long a, const bigint &b) { return bigint(a) % b; }
 bigint operator%(unsigned long a, const bigint &b) { return bigint(a) % b; }
 bigint operator%(long long a, const bigint &b) { return bigint(a) % b; }
 
+bigint bigint::operator<<(int a) const {
+    bigint t(*this);
+    return t <<= a;
+}
+bigint bigint::operator<<(unsigned a) const {
+    bigint t(*this);
+    return t <<= a;
+}
+bigint bigint::operator<<(long a) const {
+    bigint t(*this);
+    return t <<= a;
+}
+bigint bigint::operator<<(unsigned long a) const {
+    bigint t(*this);
+    return t <<= a;
+}
+bigint bigint::operator<<(long long a) const {
+    bigint t(*this);
+    return t <<= a;
+}
+
+bigint bigint::operator>>(int a) const {
+    bigint t(*this);
+    return t >>= a;
+}
+bigint bigint::operator>>(unsigned a) const {
+    bigint t(*this);
+    return t >>= a;
+}
+bigint bigint::operator>>(long a) const {
+    bigint t(*this);
+    return t >>= a;
+}
+bigint bigint::operator>>(unsigned long a) const {
+    bigint t(*this);
+    return t >>= a;
+}
+bigint bigint::operator>>(long long a) const {
+    bigint t(*this);
+    return t >>= a;
+}
+
+bigint bigint::operator&(const bigint &a) const {
+    bigint t(*this);
+    return t &= a;
+}
+bigint bigint::operator&(int a) const {
+    bigint t(*this);
+    return t &= a;
+}
+bigint bigint::operator&(unsigned a) const {
+    bigint t(*this);
+    return t &= a;
+}
+bigint bigint::operator&(long a) const {
+    bigint t(*this);
+    return t &= a;
+}
+bigint bigint::operator&(unsigned long a) const {
+    bigint t(*this);
+    return t &= a;
+}
+bigint bigint::operator&(long long a) const {
+    bigint t(*this);
+    return t &= a;
+}
+bigint operator&(int a, const bigint &b) { return bigint(a) & b; }
+bigint operator&(unsigned a, const bigint &b) { return bigint(a) & b; }
+bigint operator&(long a, const bigint &b) { return bigint(a) & b; }
+bigint operator&(unsigned long a, const bigint &b) { return bigint(a) & b; }
+bigint operator&(long long a, const bigint &b) { return bigint(a) & b; }
+
+bigint bigint::operator|(const bigint &a) const {
+    bigint t(*this);
+    return t |= a;
+}
+bigint bigint::operator|(int a) const {
+    bigint t(*this);
+    return t |= a;
+}
+bigint bigint::operator|(unsigned a) const {
+    bigint t(*this);
+    return t |= a;
+}
+bigint bigint::operator|(long a) const {
+    bigint t(*this);
+    return t |= a;
+}
+bigint bigint::operator|(unsigned long a) const {
+    bigint t(*this);
+    return t |= a;
+}
+bigint bigint::operator|(long long a) const {
+    bigint t(*this);
+    return t |= a;
+}
+bigint operator|(int a, const bigint &b) { return bigint(a) | b; }
+bigint operator|(unsigned a, const bigint &b) { return bigint(a) | b; }
+bigint operator|(long a, const bigint &b) { return bigint(a) | b; }
+bigint operator|(unsigned long a, const bigint &b) { return bigint(a) | b; }
+bigint operator|(long long a, const bigint &b) { return bigint(a) | b; }
+
+bigint bigint::operator^(const bigint &a) const {
+    bigint t(*this);
+    return t ^= a;
+}
+bigint bigint::operator^(int a) const {
+    bigint t(*this);
+    return t ^= a;
+}
+bigint bigint::operator^(unsigned a) const {
+    bigint t(*this);
+    return t ^= a;
+}
+bigint bigint::operator^(long a) const {
+    bigint t(*this);
+    return t ^= a;
+}
+bigint bigint::operator^(unsigned long a) const {
+    bigint t(*this);
+    return t ^= a;
+}
+bigint bigint::operator^(long long a) const {
+    bigint t(*this);
+    return t ^= a;
+}
+bigint operator^(int a, const bigint &b) { return bigint(a) ^ b; }
+bigint operator^(unsigned a, const bigint &b) { return bigint(a) ^ b; }
+bigint operator^(long a, const bigint &b) { return bigint(a) ^ b; }
+bigint operator^(unsigned long a, const bigint &b) { return bigint(a) ^ b; }
+bigint operator^(long long a, const bigint &b) { return bigint(a) ^ b; }
+
 bigint &bigint::operator=(const bigint &a) {
     num = a.num;
     pos = a.pos;
     return *this;
 }
+bigint &bigint::operator=(bigint &&a) noexcept {
+    num = std::move(a.num);
+    pos = a.pos;
+    return *this;
+}
 bigint &bigint::operator=(int a) { return *this = bigint(a); }
 bigint &bigint::operator=(unsigned a) { return *this = bigint(a); }
 bigint &bigint::operator=(long a) { return *this = bigint(a); }
@@ -423,90 +707,103 @@ bigint &bigint::operator=(unsigned long a) { return *this = bigint(a); }
 bigint &bigint::operator=(long long a) { return *this = bigint(a); }
 bigint &bigint::operator=(std::string a) { return *this = bigint(a); }
 
-bool bigint::operator==(const bigint &a) const {
-    if (num.at(0) == 0 && a.num.at(0) == 0 && num.size() == 1 &&
-        a.num.size() == 1)
-        return true;
-    return (pos == a.pos) && (num.size() == a.num.size()) &&
-           std::equal(num.cbegin(), num.cend(), a.num.cbegin());
-}
-bool bigint::operator==(int a) const { return *this == bigint(a); }
-bool bigint::operator==(unsigned a) const { return *this == bigint(a); }
-bool bigint::operator==(long a) const { return *this == bigint(a); }
-bool bigint::operator==(unsigned long a) const { return *this == bigint(a); }
-bool bigint::operator==(long long a) const { return *this == bigint(a); }
-
-bool bigint::operator>(const bigint &a) const {
-    if (pos ^ a.pos) {
-        if (pos) return true;
-        else
-            return false;
-    }
-    if (num.size() > a.num.size()) return true;
-    if (num.size() < a.num.size()) return false;
-    for (auto i = num.size() - 1;; --i) {
-        if (num.at(i) > a.num.at(i)) return true;
-        if (num.at(i) < a.num.at(i)) return false;
-        if (i == 0) break;
-    }
-    return false;
-}
-bool bigint::operator>(int a) const { return *this > bigint(a); }
-bool bigint::operator>(unsigned a) const { return *this > bigint(a); }
-bool bigint::operator>(long a) const { return *this > bigint(a); }
-bool bigint::operator>(unsigned long a) const { return *this > bigint(a); }
-bool operator>(int a, const bigint &b) { return b < bigint(a); }
-bool operator>(unsigned a, const bigint &b) { return b < bigint(a); }
-bool operator>(long a, const bigint &b) { return b < bigint(a); }
-bool operator>(unsigned long a, const bigint &b) { return b < bigint(a); }
-bool operator>(long long a, const bigint &b) { return b < bigint(a); }
-
-bool bigint::operator>=(const bigint &a) const { return !(*this < a); }
-bool bigint::operator>=(int a) const { return *this >= bigint(a); }
-bool bigint::operator>=(unsigned a) const { return *this >= bigint(a); }
-bool bigint::operator>=(long a) const { return *this >= bigint(a); }
-bool bigint::operator>=(unsigned long a) const { return *this >= bigint(a); }
-bool operator>=(int a, const bigint &b) { return b <= bigint(a); }
-bool operator>=(unsigned a, const bigint &b) { return b <= bigint(a); }
-bool operator>=(long a, const bigint &b) { return b <= bigint(a); }
-bool operator>=(unsigned long a, const bigint &b) { return b <= bigint(a); }
-bool operator>=(long long a, const bigint &b) { return b <= bigint(a); }
-
-bool bigint::operator<(const bigint &a) const {
-    if (pos ^ a.pos) {
-        if (pos) return false;
-        else
-            return true;
+int bigint::compare(const bigint &a) const {
+    if (num.empty() || a.num.empty()) {
+        throw std::runtime_error("compare: Object is empty.");
     }
-    if (num.size() > a.num.size()) return false;
-    if (num.size() < a.num.size()) return true;
-    for (auto i = num.size() - 1;; --i) {
-        if (num.at(i) > a.num.at(i)) return false;
-        if (num.at(i) < a.num.at(i)) return true;
-        if (i == 0) break;
+    int s = is_zero() ? 0 : pos ? 1 : -1;
+    int as = a.is_zero() ? 0 : a.pos ? 1 : -1;
+    if (s != as) return s < as ? -1 : 1;
+    return s * compare_abs(a.num.data(), a.limb_count());
+}
+int bigint::compare(int a) const {
+    return compare_native(a >= 0, magnitude(a));
+}
+int bigint::compare(unsigned a) const { return compare_native(true, a); }
+int bigint::compare(long a) const {
+    return compare_native(a >= 0, magnitude(a));
+}
+int bigint::compare(unsigned long a) const { return compare_native(true, a); }
+int bigint::compare(long long a) const {
+    return compare_native(a >= 0, magnitude(a));
+}
+std::size_t bigint::hash() const noexcept { return hash_with_sign(pos); }
+std::size_t bigint::hash_with_sign(bool p) const noexcept {
+    // Zero hashes the same whatever its sign, and leading zero limbs are
+    // skipped, so equal values always hash equally.
+    if (num.empty()) return 0;
+    std::uint64_t h = (p || is_zero()) ? 0 : 0x9e3779b97f4a7c15ull;
+    auto n = limb_count();
+    for (std::size_t i = 0; i < n; i += 2) {
+        std::uint64_t v = num[i];
+        if (i + 1 < n) v |= std::uint64_t(num[i + 1]) << 32;
+        h = (h ^ v) * 0xff51afd7ed558ccdull;
+        h ^= h >> 32;
     }
-    return false;
-}
-bool bigint::operator<(int a) const { return *this < bigint(a); }
-bool bigint::operator<(unsigned a) const { return *this < bigint(a); }
-bool bigint::operator<(long a) const { return *this < bigint(a); }
-bool bigint::operator<(unsigned long a) const { return *this < bigint(a); }
-bool operator<(int a, const bigint &b) { return b > bigint(a); }
-bool operator<(unsigned a, const bigint &b) { return b > bigint(a); }
-bool operator<(long a, const bigint &b) { return b > bigint(a); }
-bool operator<(unsigned long a, const bigint &b) { return b > bigint(a); }
-bool operator<(long long a, const bigint &b) { return b > bigint(a); }
-
-bool bigint::operator<=(const bigint &a) const { return !(*this > a); }
-bool bigint::operator<=(int a) const { return *this <= bigint(a); }
-bool bigint::operator<=(unsigned a) const { return *this <= bigint(a); }
-bool bigint::operator<=(long a) const { return *this <= bigint(a); }
-bool bigint::operator<=(unsigned long a) const { return *this <= bigint(a); }
-bool operator<=(int a, const bigint &b) { return b >= bigint(a); }
-bool operator<=(unsigned a, const bigint &b) { return b >= bigint(a); }
-bool operator<=(long a, const bigint &b) { return b >= bigint(a); }
-bool operator<=(unsigned long a, const bigint &b) { return b >= bigint(a); }
-bool operator<=(long long a, const bigint &b) { return b >= bigint(a); }
+    return std::size_t(h);
+}
+
+bool bigint::operator==(const bigint &a) const { return compare(a) == 0; }
+bool bigint::operator==(int a) const { return compare(a) == 0; }
+bool bigint::operator==(unsigned a) const { return compare(a) == 0; }
+bool bigint::operator==(long a) const { return compare(a) == 0; }
+bool bigint::operator==(unsigned long a) const { return compare(a) == 0; }
+bool bigint::operator==(long long a) const { return compare(a) == 0; }
+
+bool bigint::operator!=(const bigint &a) const { return compare(a) != 0; }
+bool bigint::operator!=(int a) const { return compare(a) != 0; }
+bool bigint::operator!=(unsigned a) const { return compare(a) != 0; }
+bool bigint::operator!=(long a) const { return compare(a) != 0; }
+bool bigint::operator!=(unsigned long a) const { return compare(a) != 0; }
+bool bigint::operator!=(long long a) const { return compare(a) != 0; }
+
+bool bigint::operator>(const bigint &a) const { return compare(a) > 0; }
+bool bigint::operator>(int a) const { return compare(a) > 0; }
+bool bigint::operator>(unsigned a) const { return compare(a) > 0; }
+bool bigint::operator>(long a) const { return compare(a) > 0; }
+bool bigint::operator>(unsigned long a) const { return compare(a) > 0; }
+bool bigint::operator>(long long a) const { return compare(a) > 0; }
+bool operator>(int a, const bigint &b) { return b.compare(a) < 0; }
+bool operator>(unsigned a, const bigint &b) { return b.compare(a) < 0; }
+bool operator>(long a, const bigint &b) { return b.compare(a) < 0; }
+bool operator>(unsigned long a, const bigint &b) { return b.compare(a) < 0; }
+bool operator>(long long a, const bigint &b) { return b.compare(a) < 0; }
+
+bool bigint::operator>=(const bigint &a) const { return compare(a) >= 0; }
+bool bigint::operator>=(int a) const { return compare(a) >= 0; }
+bool bigint::operator>=(unsigned a) const { return compare(a) >= 0; }
+bool bigint::operator>=(long a) const { return compare(a) >= 0; }
+bool bigint::operator>=(unsigned long a) const { return compare(a) >= 0; }
+bool bigint::operator>=(long long a) const { return compare(a) >= 0; }
+bool operator>=(int a, const bigint &b) { return b.compare(a) <= 0; }
+bool operator>=(unsigned a, const bigint &b) { return b.compare(a) <= 0; }
+bool operator>=(long a, const bigint &b) { return b.compare(a) <= 0; }
+bool operator>=(unsigned long a, const bigint &b) { return b.compare(a) <= 0; }
+bool operator>=(long long a, const bigint &b) { return b.compare(a) <= 0; }
+
+bool bigint::operator<(const bigint &a) const { return compare(a) < 0; }
+bool bigint::operator<(int a) const { return compare(a) < 0; }
+bool bigint::operator<(unsigned a) const { return compare(a) < 0; }
+bool bigint::operator<(long a) const { return compare(a) < 0; }
+bool bigint::operator<(unsigned long a) const { return compare(a) < 0; }
+bool bigint::operator<(long long a) const { return compare(a) < 0; }
+bool operator<(int a, const bigint &b) { return b.compare(a) > 0; }
+bool operator<(unsigned a, const bigint &b) { return b.compare(a) > 0; }
+bool operator<(long a, const bigint &b) { return b.compare(a) > 0; }
+bool operator<(unsigned long a, const bigint &b) { return b.compare(a) > 0; }
+bool operator<(long long a, const bigint &b) { return b.compare(a) > 0; }
+
+bool bigint::operator<=(const bigint &a) const { return compare(a) <= 0; }
+bool bigint::operator<=(int a) const { return compare(a) <= 0; }
+bool bigint::operator<=(unsigned a) const { return compare(a) <= 0; }
+bool bigint::operator<=(long a) const { return compare(a) <= 0; }
+bool bigint::operator<=(unsigned long a) const { return compare(a) <= 0; }
+bool bigint::operator<=(long long a) const { return compare(a) <= 0; }
+bool operator<=(int a, const bigint &b) { return b.compare(a) >= 0; }
+bool operator<=(unsigned a, const bigint &b) { return b.compare(a) >= 0; }
+bool operator<=(long a, const bigint &b) { return b.compare(a) >= 0; }
+bool operator<=(unsigned long a, const bigint &b) { return b.compare(a) >= 0; }
+bool operator<=(long long a, const bigint &b) { return b.compare(a) >= 0; }
 
 bigint pow(const bigint &a, int b) {
     bigint r = 1;
@@ -516,5 +813,203 @@ bigint pow(const bigint &a, int b) {
     return r;
 }
 bigint abs(const bigint &a) { return a.abs(); }
+bigint abs(bigint &&a) { return std::move(a).abs(); }
+bigint gcd(const bigint &a, const bigint &b) {
+    bigint x = a.abs(), y = b.abs(), q, r;
+    while (!y.is_zero()) {
+        divmod(q, r, x, y);
+        x.num.swap(y.num);
+        y.num.swap(r.num);
+    }
+    return x;
+}
+
+void bigint::reserve(std::size_t n) { num.reserve(n); }
+std::size_t bigint::capacity() const { return num.capacity(); }
+void bigint::shrink_to_fit() { num.shrink_to_fit(); }
+
+void add(bigint &r, const bigint &a, const bigint &b) {
+    if (a.num.empty() || b.num.empty()) {
+        throw std::runtime_error("add: Object is empty.");
+    }
+    BIGINT_TRACE_OP(trace_op::add, a, b);
+    bool ap = a.pos, bp = b.pos;
+    if (ap == bp) {
+        bigint::add_abs(r.num, a.num, b.num);
+        r.pos = ap;
+    } else if (bigint::compare_abs(a.num, b.num) >= 0) {
+        bigint::sub_abs(r.num, a.num, b.num);
+        r.pos = ap;
+    } else {
+        bigint::sub_abs(r.num, b.num, a.num);
+        r.pos = bp;
+    }
+    if (r.is_zero()) r.pos = true;
+}
+void sub(bigint &r, const bigint &a, const bigint &b) {
+    if (a.num.empty() || b.num.empty()) {
+        throw std::runtime_error("sub: Object is empty.");
+    }
+    BIGINT_TRACE_OP(trace_op::sub, a, b);
+    bool ap = a.pos, bp = !b.pos;
+    if (ap == bp) {
+        bigint::add_abs(r.num, a.num, b.num);
+        r.pos = ap;
+    } else if (bigint::compare_abs(a.num, b.num) >= 0) {
+        bigint::sub_abs(r.num, a.num, b.num);
+        r.pos = ap;
+    } else {
+        bigint::sub_abs(r.num, b.num, a.num);
+        r.pos = bp;
+    }
+    if (r.is_zero()) r.pos = true;
+}
+void mul(bigint &r, const bigint &a, const bigint &b) {
+    if (a.num.empty() || b.num.empty()) {
+        throw std::runtime_error("mul: Object is empty.");
+    }
+    BIGINT_TRACE_OP(trace_op::mul, a, b);
+    bool p = a.pos == b.pos;
+    bigint::mul_abs(r.num, a.num, b.num);
+    r.pos = p || r.is_zero();
+}
+void divmod(bigint &q, bigint &r, const bigint &a, const bigint &b) {
+    if (&q == &r) {
+        throw std::invalid_argument("divmod: Quotient and remainder alias.");
+    }
+    if (a.num.empty() || b.num.empty()) {
+        throw std::runtime_error("divmod: Object is empty.");
+    }
+    if (b.is_zero()) throw std::runtime_error("Division by zero");
+    BIGINT_TRACE_OP(trace_op::divmod, a, b);
+    bool qp = a.pos == b.pos, rp = a.pos;
+    bigint::divmod_abs(q.num, r.num, a.num, b.num);
+    q.pos = qp || q.is_zero();
+    r.pos = rp || r.is_zero();
+}
+void addmul(bigint &r, const bigint &a, const bigint &b) {
+    thread_local bigint t;
+    mul(t, a, b);
+    add(r, r, t);
+}
+void submul(bigint &r, const bigint &a, const bigint &b) {
+    thread_local bigint t;
+    mul(t, a, b);
+    sub(r, r, t);
+}
+
+namespace {
+void check_word_format(int order, std::size_t size, int endian) {
+    if ((order != 1 && order != -1) || size == 0 || endian < -1 || endian > 1)
+        throw std::invalid_argument("Invalid argument.");
+}
+bool little_endian(int endian) {
+    if (endian != 0) return endian < 0;
+    const std::uint16_t one = 1;
+    unsigned char b;
+    std::memcpy(&b, &one, 1);
+    return b == 1;
+}
+// Offset of byte j of word k, both counted from the least significant.
+std::size_t byte_offset(std::size_t k, std::size_t j, std::size_t count,
+                        int order, std::size_t size, bool little) {
+    auto word = order < 0 ? k : count - 1 - k;
+    return word * size + (little ? j : size - 1 - j);
+}
+}  // namespace
+
+void import_words(bigint &r, std::size_t count, int order, std::size_t size,
+                  int endian, const void *data) {
+    check_word_format(order, size, endian);
+    bool little = little_endian(endian);
+    auto p = static_cast<const unsigned char *>(data);
+    std::vector<unsigned> w((count * size + 3) / 4, 0);
+    if (order < 0 && little && size == 4 && little_endian(0)) {
+        std::memcpy(w.data(), p, count * size);
+    } else {
+        for (std::size_t k = 0; k < count; ++k) {
+            for (std::size_t j = 0; j < size; ++j) {
+                auto b = k * size + j;
+                unsigned e = p[byte_offset(k, j, count, order, size, little)];
+                w[b / 4] |= e << (8 * (b % 4));
+            }
+        }
+    }
+    r = bigint::from_binary(w, true);
+}
+std::size_t export_words(void *data, int order, std::size_t size,
+                         int endian, const bigint &a) {
+    check_word_format(order, size, endian);
+    if (a.num.empty()) {
+        throw std::runtime_error("export_words: Object is empty.");
+    }
+    bool little = little_endian(endian);
+    auto p = static_cast<unsigned char *>(data);
+    auto w = a.to_binary();
+    auto byte = [&](std::size_t b) {
+        return (w[b / 4] >> (8 * (b % 4))) & 0xff;
+    };
+    auto bytes = 4 * w.size();
+    while (bytes > 0 && byte(bytes - 1) == 0) --bytes;
+    auto count = (bytes + size - 1) / size;
+    for (std::size_t k = 0; k < count; ++k) {
+        for (std::size_t j = 0; j < size; ++j) {
+            auto b = k * size + j;
+            p[byte_offset(k, j, count, order, size, little)] =
+                b < bytes ? (unsigned char)byte(b) : 0;
+        }
+    }
+    return count;
+}
+std::size_t export_count(const bigint &a, std::size_t size) {
+    if (size == 0) throw std::invalid_argument("Invalid argument.");
+    return (a.bit_length() + 8 * size - 1) / (8 * size);
+}
+
+bigint bigint::from_binary(const std::vector<unsigned> &w, bool p) {
+    bigint r(0u, p);
+    detail::power_cache_reader c;
+    from_binary(w.data(), w.size(), r.num, c);
+    r.trim();
+    if (r.is_zero()) r.pos = true;
+    return r;
+}
+// x = the n words at w, least significant first.
+void bigint::from_binary(const unsigned *w, std::size_t n,
+                         std::vector<unsigned> &x,
+                         detail::power_cache_reader &c) {
+    // Horner's rule up to the binary_split threshold, then a split at
+    // 2^(32 * 2^j) so the halves are combined by one large multiplication.
+    using detail::binary_split_threshold;
+    if (n <= binary_split_threshold.load(std::memory_order_relaxed)) {
+        x.assign(1, 0);
+        for (auto i = n; i-- > 0;) {
+            unsigned long long carry = w[i];
+            for (auto &e : x) {
+                carry += (unsigned long long)e << 32;
+                e = carry % base;
+                carry /= base;
+            }
+            for (; carry != 0; carry /= base) x.push_back(carry % base);
+        }
+        return;
+    }
+    std::size_t j = 0;
+    while ((std::size_t(2) << j) < n) ++j;
+    auto h = std::size_t(1) << j;
+    std::vector<unsigned> hi;
+    from_binary(w + h, n - h, hi, c);
+    from_binary(w, h, x, c);
+    mul_abs(hi, hi, c.binary_power(j).num);
+    add_abs(x, x, hi);
+}
+bigint bigint::pow2(unsigned long k) {
+    bigint r(1u << (k % 32));
+    detail::power_cache_reader c;
+    auto m = k / 32;
+    for (std::size_t j = 0; m != 0; ++j, m >>= 1)
+        if (m & 1) mul_abs(r.num, r.num, c.binary_power(j).num);
+    return r;
+}
 
 }  // namespace extypes
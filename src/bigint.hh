@@ -26,14 +26,75 @@
 #include <cctype>
 #include <climits>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <iomanip>
 #include <iostream>
+#include <limits>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <vector>
 
+#include "thresholds.hh"
+#include "trace.hh"
+
+#if __cpp_impl_three_way_comparison >= 201907L
+#include <compare>
+#endif
+#if __cplusplus > 201703L && __has_include(<span>)
+#include <span>
+#endif
+
 namespace extypes {
+#ifdef __SIZEOF_INT128__
+__extension__ typedef __int128 int128;
+__extension__ typedef unsigned __int128 uint128;
+#endif
+
+namespace detail {
+class power_cache_reader;
+
+// std::make_unsigned, which does not know __int128 in strict ISO mode.
+template <typename T>
+struct unsigned_of {
+    using type = std::make_unsigned_t<T>;
+};
+#ifdef __SIZEOF_INT128__
+template <>
+struct unsigned_of<int128> {
+    using type = uint128;
+};
+template <>
+struct unsigned_of<uint128> {
+    using type = uint128;
+};
+#endif
+}  // namespace detail
+
+// Read-only view of base-10^9 limbs, least significant first.
+#ifdef __cpp_lib_span
+using limb_span = std::span<const unsigned>;
+#else
+class limb_span {
+  public:
+    limb_span(const unsigned *d, std::size_t n) : first(d), count(n) {}
+    const unsigned *data() const { return first; }
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const unsigned *begin() const { return first; }
+    const unsigned *end() const { return first + count; }
+    unsigned operator[](std::size_t i) const { return first[i]; }
+
+  private:
+    const unsigned *first;
+    std::size_t count;
+};
+#endif
+
 struct bigint {
     bigint();
     bigint(int);
@@ -41,14 +102,30 @@ struct bigint {
     bigint(long);
     bigint(unsigned long, bool p = true);
     bigint(long long);
+    // Takes the limbs (each below 10^9, least significant first); pass an
+    // rvalue to adopt the buffer without copying.
     bigint(std::vector<unsigned>, bool p = true);
     bigint(std::string);
     bigint(const bigint &);
+    bigint(bigint &&) noexcept;
+#ifdef __SIZEOF_INT128__
+    bigint(int128);
+    bigint(uint128, bool p = true);
+#endif
+    // Truncates toward zero; throws std::invalid_argument for NaN and
+    // infinities.
+    static bigint from_double(double);
 
     bool sign() const;
-    bigint abs() const;
+    // The rvalue overloads reuse the operand's limbs.
+    bigint abs() const &;
+    bigint abs() &&;
     bigint fact() const;
     std::string::size_type digits() const;
+    std::size_t bit_length() const;
+    std::size_t popcount() const;
+    bool test_bit(std::size_t) const;
+    unsigned remainder(unsigned) const;
 
     std::string to_string() const;
     friend std::ostream &operator<<(std::ostream &, const bigint &);
@@ -58,9 +135,40 @@ struct bigint {
     operator unsigned() const;
     operator long() const;
     operator unsigned long() const;
+#ifdef __SIZEOF_INT128__
+    explicit operator int128() const;
+    explicit operator uint128() const;
+#endif
+
+    // Whether the value is representable in the integral type T. Only the
+    // few limbs a T can hold are looked at, so this is O(1).
+    template <typename T>
+    bool fits_in() const {
+        T r{};
+        return convert_to(r);
+    }
+    // The value as T, or std::nullopt if it does not fit (or is NaN).
+    template <typename T>
+    std::optional<T> try_convert() const {
+        T r{};
+        if (!convert_to(r)) return std::nullopt;
+        return r;
+    }
 
-    bigint operator+() const;
-    bigint operator-() const;
+    // Nearest double (ties to even), +-HUGE_VAL past the double range and a
+    // quiet NaN for NaN.
+    double to_double() const;
+    // m with 0.5 <= |m| < 1 (0 for zero) and e such that *this is m * 2^e,
+    // m rounded to nearest like to_double(), but without the range limit.
+    // Converts the whole value with to_binary(), so it is O(n^2) in the
+    // limbs; to_double() stays cheap by saturating from 36 limbs on.
+    double frexp(long &e) const;
+
+    bigint operator+() const &;
+    bigint operator+() &&;
+    bigint operator-() const &;
+    bigint operator-() &&;
+    bigint operator~() const;
 
     bigint &operator++();
     bigint operator++(int);
@@ -68,6 +176,9 @@ struct bigint {
     bigint operator--(int);
 
     unsigned operator[](int) const;
+    // Limbs without leading zeros; empty for NaN. Valid until *this is
+    // modified.
+    limb_span limbs() const;
 
     bigint &operator+=(const bigint &);
     bigint &operator+=(int);
@@ -104,6 +215,39 @@ struct bigint {
     bigint &operator%=(unsigned long);
     bigint &operator%=(long long);
 
+    bigint &operator<<=(int);
+    bigint &operator<<=(unsigned);
+    bigint &operator<<=(long);
+    bigint &operator<<=(unsigned long);
+    bigint &operator<<=(long long);
+
+    bigint &operator>>=(int);
+    bigint &operator>>=(unsigned);
+    bigint &operator>>=(long);
+    bigint &operator>>=(unsigned long);
+    bigint &operator>>=(long long);
+
+    bigint &operator&=(const bigint &);
+    bigint &operator&=(int);
+    bigint &operator&=(unsigned);
+    bigint &operator&=(long);
+    bigint &operator&=(unsigned long);
+    bigint &operator&=(long long);
+
+    bigint &operator|=(const bigint &);
+    bigint &operator|=(int);
+    bigint &operator|=(unsigned);
+    bigint &operator|=(long);
+    bigint &operator|=(unsigned long);
+    bigint &operator|=(long long);
+
+    bigint &operator^=(const bigint &);
+    bigint &operator^=(int);
+    bigint &operator^=(unsigned);
+    bigint &operator^=(long);
+    bigint &operator^=(unsigned long);
+    bigint &operator^=(long long);
+
     bigint operator+(const bigint &) const;
     bigint operator+(int) const;
     bigint operator+(unsigned) const;
@@ -164,7 +308,56 @@ struct bigint {
     friend bigint operator%(unsigned long, const bigint &);
     friend bigint operator%(long long, const bigint &);
 
+    bigint operator<<(int) const;
+    bigint operator<<(unsigned) const;
+    bigint operator<<(long) const;
+    bigint operator<<(unsigned long) const;
+    bigint operator<<(long long) const;
+
+    bigint operator>>(int) const;
+    bigint operator>>(unsigned) const;
+    bigint operator>>(long) const;
+    bigint operator>>(unsigned long) const;
+    bigint operator>>(long long) const;
+
+    bigint operator&(const bigint &) const;
+    bigint operator&(int) const;
+    bigint operator&(unsigned) const;
+    bigint operator&(long) const;
+    bigint operator&(unsigned long) const;
+    bigint operator&(long long) const;
+    friend bigint operator&(int, const bigint &);
+    friend bigint operator&(unsigned, const bigint &);
+    friend bigint operator&(long, const bigint &);
+    friend bigint operator&(unsigned long, const bigint &);
+    friend bigint operator&(long long, const bigint &);
+
+    bigint operator|(const bigint &) const;
+    bigint operator|(int) const;
+    bigint operator|(unsigned) const;
+    bigint operator|(long) const;
+    bigint operator|(unsigned long) const;
+    bigint operator|(long long) const;
+    friend bigint operator|(int, const bigint &);
+    friend bigint operator|(unsigned, const bigint &);
+    friend bigint operator|(long, const bigint &);
+    friend bigint operator|(unsigned long, const bigint &);
+    friend bigint operator|(long long, const bigint &);
+
+    bigint operator^(const bigint &) const;
+    bigint operator^(int) const;
+    bigint operator^(unsigned) const;
+    bigint operator^(long) const;
+    bigint operator^(unsigned long) const;
+    bigint operator^(long long) const;
+    friend bigint operator^(int, const bigint &);
+    friend bigint operator^(unsigned, const bigint &);
+    friend bigint operator^(long, const bigint &);
+    friend bigint operator^(unsigned long, const bigint &);
+    friend bigint operator^(long long, const bigint &);
+
     bigint &operator=(const bigint &);
+    bigint &operator=(bigint &&) noexcept;
     bigint &operator=(int);
     bigint &operator=(unsigned);
     bigint &operator=(long);
@@ -172,6 +365,14 @@ struct bigint {
     bigint &operator=(long long);
     bigint &operator=(std::string);
 
+    int compare(const bigint &) const;
+    int compare(int) const;
+    int compare(unsigned) const;
+    int compare(long) const;
+    int compare(unsigned long) const;
+    int compare(long long) const;
+    std::size_t hash() const noexcept;
+
     bool operator==(const bigint &) const;
     bool operator==(int) const;
     bool operator==(unsigned) const;
@@ -179,6 +380,13 @@ struct bigint {
     bool operator==(unsigned long) const;
     bool operator==(long long) const;
 
+    bool operator!=(const bigint &) const;
+    bool operator!=(int) const;
+    bool operator!=(unsigned) const;
+    bool operator!=(long) const;
+    bool operator!=(unsigned long) const;
+    bool operator!=(long long) const;
+
     bool operator>(const bigint &) const;
     bool operator>(int) const;
     bool operator>(unsigned) const;
@@ -227,8 +435,50 @@ struct bigint {
     friend bool operator<=(unsigned long, const bigint &);
     friend bool operator<=(long long, const bigint &);
 
+#if __cpp_impl_three_way_comparison >= 201907L
+    std::strong_ordering operator<=>(const bigint &a) const {
+        return compare(a) <=> 0;
+    }
+#endif
+
     friend bigint pow(const bigint &, int);
     friend bigint abs(const bigint &);
+    friend bigint abs(bigint &&);
+    friend bigint gcd(const bigint &, const bigint &);
+
+    void reserve(std::size_t);
+    std::size_t capacity() const;
+    void shrink_to_fit();
+
+    friend void add(bigint &, const bigint &, const bigint &);
+    friend void sub(bigint &, const bigint &, const bigint &);
+    friend void mul(bigint &, const bigint &, const bigint &);
+    friend void divmod(bigint &, bigint &, const bigint &, const bigint &);
+    friend void addmul(bigint &, const bigint &, const bigint &);
+    friend void submul(bigint &, const bigint &, const bigint &);
+
+    // Word import/export in the manner of GMP's mpz_import/mpz_export:
+    // count words of `size` bytes, most significant word first if order is
+    // 1 and least significant first if -1, bytes within a word big-endian
+    // if endian is 1, little-endian if -1 and native if 0. Signs are not
+    // transferred; imports are non-negative and exports write |a|.
+    friend void import_words(bigint &, std::size_t count, int order,
+                             std::size_t size, int endian, const void *);
+    friend std::size_t export_words(void *, int order, std::size_t size,
+                                    int endian, const bigint &);
+    // Number of words export_words() writes, 0 for zero.
+    friend std::size_t export_count(const bigint &, std::size_t size);
+
+    friend bigint read_decimal(const std::string &, unsigned);
+    friend void write_decimal(const std::string &, const bigint &, unsigned);
+
+    template <std::size_t>
+    friend struct bigint_fixed;
+    friend struct bigrational;
+    friend struct bigdecimal;
+    friend struct bigint_accumulator;
+    friend struct shared_bigint;
+    friend struct trace_scope;
 
   private:
     std::vector<unsigned> num;
@@ -240,79 +490,489 @@ struct bigint {
         if (num.empty() || a.num.empty()) {
             throw std::runtime_error("Operator*=: Object is empty.");
         }
-        bigint t(*this);
-        auto min_dim = t.num.size() + a.num.size() - 2;
-        num.clear();
-        num.resize(min_dim + 1);
-        for (auto it_t = t.num.begin(); it_t != t.num.end(); ++it_t)
-            for (auto it_a = a.num.begin(); it_a != a.num.end(); ++it_a) {
-                auto dim = (it_a - a.num.begin()) + (it_t - t.num.begin());
-                unsigned long long tmp =
-                    (unsigned long long)*it_t * (unsigned long long)*it_a;
-                for (int i = 0; tmp != 0; ++i) {
-                    if (dim + (unsigned long)i < num.size()) {
-                        tmp += num.at(dim + i);
-                        num.at(dim + i) = tmp % base;
-                    } else
-                        num.push_back(tmp % base);
-                    tmp /= base;
-                }
-            }
-        pos ^= !a.pos;
+        BIGINT_TRACE_OP(trace_op::mul, *this, a);
+        bool p = pos == a.pos;
+        mul_abs(num, num, a.num);
+        pos = p || is_zero();
         return *this;
     }
 
     bigint &division_a(const bigint &s) {
-        bigint t = (*this).abs();
-        bigint a = s.abs();
-        if (num.empty() || a.num.empty()) {
+        if (num.empty() || s.num.empty()) {
             throw std::runtime_error("Operator/=: Object is empty.");
         }
-        if (a == 0) throw std::runtime_error("Division by zero");
-        if (t < a) {
-            num.clear();
-            num.push_back(0);
-            return *this;
+        thread_local bigint r;
+        divmod(*this, r, *this, s);
+        return *this;
+    }
+
+    // Magnitude kernels on limb vectors.  Leading zero limbs of the inputs
+    // are ignored and the result is trimmed.  The output is resized in
+    // place, so a destination that already has the capacity is not
+    // reallocated.
+
+    static std::size_t limb_count(const std::vector<unsigned> &a) {
+        auto n = a.size();
+        while (n > 1 && a[n - 1] == 0) --n;
+        return n;
+    }
+
+    static void trim(std::vector<unsigned> &a) {
+        while (a.size() > 1 && a.back() == 0) a.pop_back();
+    }
+
+    static int compare_abs(const std::vector<unsigned> &a,
+                           const std::vector<unsigned> &b) {
+        auto la = limb_count(a), lb = limb_count(b);
+        if (la != lb) return la < lb ? -1 : 1;
+        for (auto i = la; i-- > 0;)
+            if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+        return 0;
+    }
+
+    // r = |a| + |b|; r may alias a or b.
+    static void add_abs(std::vector<unsigned> &r,
+                        const std::vector<unsigned> &a,
+                        const std::vector<unsigned> &b) {
+        auto la = limb_count(a), lb = limb_count(b);
+        if (la < lb) return add_abs(r, b, a);
+        r.resize(la);
+        unsigned carry = 0;
+        for (std::size_t i = 0; i < la; ++i) {
+            unsigned e = a[i] + (i < lb ? b[i] : 0) + carry;
+            carry = e >= base;
+            r[i] = carry ? e - base : e;
         }
-        if (t == a) {
-            num.clear();
-            num.push_back(1);
-            pos ^= !s.pos;
-            return *this;
+        if (carry) r.push_back(carry);
+    }
+
+    // r = |a| - |b| for |a| >= |b|; r may alias a or b.
+    static void sub_abs(std::vector<unsigned> &r,
+                        const std::vector<unsigned> &a,
+                        const std::vector<unsigned> &b) {
+        auto la = limb_count(a), lb = limb_count(b);
+        r.resize(la);
+        unsigned borrow = 0;
+        for (std::size_t i = 0; i < la; ++i) {
+            unsigned s = (i < lb ? b[i] : 0) + borrow;
+            borrow = a[i] < s;
+            r[i] = borrow ? a[i] + base - s : a[i] - s;
+        }
+        trim(r);
+    }
+
+    // r = |a| * |b|; when r aliases an operand the product is built in a
+    // per-thread scratch buffer which then trades places with r.
+    static void mul_abs(std::vector<unsigned> &r,
+                        const std::vector<unsigned> &a,
+                        const std::vector<unsigned> &b) {
+        if (&r == &a || &r == &b) {
+            thread_local std::vector<unsigned> t;
+            mul_abs(t, a, b);
+            r.swap(t);
+            return;
+        }
+        auto la = limb_count(a), lb = limb_count(b);
+        r.resize(la + lb);
+        mul_limbs(r.data(), a.data(), la, b.data(), lb);
+        trim(r);
+    }
+
+    // r[0, la + lb) = a[0, la) * b[0, lb); r must not overlap a or b.
+    static void mul_limbs(unsigned *r, const unsigned *a, std::size_t la,
+                          const unsigned *b, std::size_t lb) {
+        if (a == b && la == lb) return sqr_limbs(r, a, la);
+        if (la < lb) {
+            std::swap(a, b);
+            std::swap(la, lb);
+        }
+        using detail::karatsuba_threshold;
+        if (lb < karatsuba_threshold.load(std::memory_order_relaxed)) {
+            std::fill(r, r + la + lb, 0);
+            for (std::size_t i = 0; i < la; ++i) {
+                if (a[i] == 0) continue;
+                unsigned long long carry = 0;
+                for (std::size_t j = 0; j < lb; ++j) {
+                    carry += r[i + j] + (unsigned long long)a[i] * b[j];
+                    r[i + j] = carry % base;
+                    carry /= base;
+                }
+                r[i + lb] = unsigned(carry);
+            }
+            return;
+        }
+        auto h = (la + 1) / 2;
+        if (lb <= h) {
+            // Unbalanced: a0 * b + a1 * b * base^h.
+            std::vector<unsigned> t(la - h + lb);
+            mul_limbs(r, a, h, b, lb);
+            std::fill(r + h + lb, r + la + lb, 0);
+            mul_limbs(t.data(), a + h, la - h, b, lb);
+            add_limbs(r + h, la + lb - h, t.data(), t.size());
+            return;
+        }
+        // a0 * b0 + ((a0 + a1)(b0 + b1) - a0 * b0 - a1 * b1) * base^h
+        //   + a1 * b1 * base^2h
+        std::vector<unsigned> sa(a, a + h), sb(b, b + h), m(2 * h + 2);
+        sa.push_back(0);
+        sb.push_back(0);
+        add_limbs(sa.data(), h + 1, a + h, la - h);
+        add_limbs(sb.data(), h + 1, b + h, lb - h);
+        mul_limbs(r, a, h, b, h);
+        mul_limbs(r + 2 * h, a + h, la - h, b + h, lb - h);
+        mul_limbs(m.data(), sa.data(), h + 1, sb.data(), h + 1);
+        sub_limbs(m.data(), m.size(), r, 2 * h);
+        sub_limbs(m.data(), m.size(), r + 2 * h, la + lb - 2 * h);
+        add_limbs(r + h, la + lb - h, m.data(), m.size());
+    }
+
+    // r[0, 2n) = a[0, n)^2; r must not overlap a. Each cross product is
+    // computed once and doubled, and Karatsuba needs three squares.
+    static void sqr_limbs(unsigned *r, const unsigned *a, std::size_t n) {
+        using detail::karatsuba_threshold;
+        if (n < karatsuba_threshold.load(std::memory_order_relaxed)) {
+            std::fill(r, r + 2 * n, 0);
+            for (std::size_t i = 0; i < n; ++i) {
+                unsigned long long carry = 0;
+                for (std::size_t j = i + 1; j < n; ++j) {
+                    carry += r[i + j] + (unsigned long long)a[i] * a[j];
+                    r[i + j] = carry % base;
+                    carry /= base;
+                }
+                r[i + n] = unsigned(carry);
+            }
+            unsigned carry = 0;
+            for (std::size_t i = 0; i < 2 * n; ++i) {
+                unsigned e = 2 * r[i] + carry;
+                carry = e >= base;
+                r[i] = carry ? e - base : e;
+            }
+            unsigned long long c = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                unsigned long long s = (unsigned long long)a[i] * a[i];
+                c += r[2 * i] + s % base;
+                r[2 * i] = c % base;
+                c = c / base + r[2 * i + 1] + s / base;
+                r[2 * i + 1] = c % base;
+                c /= base;
+            }
+            return;
+        }
+        // a0^2 + ((a0 + a1)^2 - a0^2 - a1^2) * base^h + a1^2 * base^2h
+        auto h = (n + 1) / 2;
+        std::vector<unsigned> s(a, a + h), m(2 * h + 2);
+        s.push_back(0);
+        add_limbs(s.data(), h + 1, a + h, n - h);
+        sqr_limbs(r, a, h);
+        sqr_limbs(r + 2 * h, a + h, n - h);
+        sqr_limbs(m.data(), s.data(), h + 1);
+        sub_limbs(m.data(), m.size(), r, 2 * h);
+        sub_limbs(m.data(), m.size(), r + 2 * h, 2 * (n - h));
+        add_limbs(r + h, 2 * n - h, m.data(), m.size());
+    }
+
+    // r[0, n) += a[0, m) with carry; any carry out of r is dropped, and
+    // leading limbs of a past n must be zero.
+    static void add_limbs(unsigned *r, std::size_t n, const unsigned *a,
+                          std::size_t m) {
+        unsigned carry = 0;
+        for (std::size_t i = 0; i < n && (i < m || carry); ++i) {
+            unsigned e = r[i] + (i < m ? a[i] : 0) + carry;
+            carry = e >= base;
+            r[i] = carry ? e - base : e;
+        }
+    }
+
+    // r[0, n) -= a[0, m) for r >= a.
+    static void sub_limbs(unsigned *r, std::size_t n, const unsigned *a,
+                          std::size_t m) {
+        unsigned borrow = 0;
+        for (std::size_t i = 0; i < n && (i < m || borrow); ++i) {
+            unsigned s = (i < m ? a[i] : 0) + borrow;
+            borrow = r[i] < s;
+            r[i] = borrow ? r[i] + base - s : r[i] - s;
         }
-        auto div_t = num.size() - a.num.size() + 1;
-        pos ^= !s.pos;
-        a = a.abs();
-        t = t.abs();
-        num.clear();
-        num.resize(div_t, 0);
-        auto ot_size = t.num.size();
-        for (auto i = ot_size - 1; i >= ot_size - div_t; --i) {
-            if (i >= t.num.size()) {
-                num.at(ot_size - i - 1) = 0;
-                continue;
+    }
+
+    // q = |a| / |b|, r = |a| % |b| (Knuth, TAOCP 4.3.1, algorithm D).
+    // q and r must differ; either may alias a, and b is only read before
+    // q and r are written.
+    static void divmod_abs(std::vector<unsigned> &q, std::vector<unsigned> &r,
+                           const std::vector<unsigned> &a,
+                           const std::vector<unsigned> &b) {
+        auto la = limb_count(a), n = limb_count(b);
+        if (n == 1) {
+            unsigned long long d = b[0], rem = 0;
+            q.resize(la);
+            for (auto i = la; i-- > 0;) {
+                rem = rem * base + a[i];
+                q[i] = unsigned(rem / d);
+                rem %= d;
             }
-            long long tmp = t.num.at(i);
-            if (i != ot_size - 1 && i + 1 < t.num.size())
-                tmp += (long long)(t.num.at(i + 1)) * base;
-            unsigned q = unsigned(tmp / a.num.at(a.num.size() - 1));
-            num.at(ot_size - i - 1) = q;
-            std::vector<unsigned> bs = {1};
-            for (unsigned long j = 0; j < i; ++j) bs.push_back(0);
-            std::reverse(bs.begin(), bs.end());
-            bigint bbs(bs);
-            t -= a * q * bbs;
-            if (i == 0) break;
+            trim(q);
+            r.assign(1, unsigned(rem));
+            return;
         }
-        std::reverse(num.begin(), num.end());
-        for (unsigned long i = num.size() - 1; i >= 1; --i) {
-            if (num.at(i) == 0) num.pop_back();
+        if (compare_abs(a, b) < 0) {
+            if (&r != &a) r.assign(a.begin(), a.begin() + la);
             else
-                break;
+                r.resize(la);
+            q.assign(1, 0);
+            return;
+        }
+
+        unsigned long long d = base / ((unsigned long long)b[n - 1] + 1);
+        thread_local std::vector<unsigned> v;
+        v.assign(b.begin(), b.begin() + n);
+        mul_small(v, d);
+        // u holds the normalized dividend and ends up as the remainder.
+        auto &u = r;
+        if (&u != &a) u.assign(a.begin(), a.begin() + la);
+        else
+            u.resize(la);
+        mul_small(u, d);
+        u.resize(la + 1, 0);
+
+        auto m = la - n;
+        q.assign(m + 1, 0);
+        for (auto j = m + 1; j-- > 0;) {
+            unsigned long long top =
+                (unsigned long long)u[j + n] * base + u[j + n - 1];
+            unsigned long long qhat = top / v[n - 1], rhat = top % v[n - 1];
+            while (qhat >= base ||
+                   qhat * v[n - 2] > rhat * base + u[j + n - 2]) {
+                --qhat;
+                rhat += v[n - 1];
+                if (rhat >= base) break;
+            }
+            unsigned long long carry = 0;
+            long long borrow = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                carry += qhat * v[i];
+                long long t = (long long)u[i + j] - (long long)(carry % base) -
+                              borrow;
+                carry /= base;
+                borrow = t < 0;
+                u[i + j] = unsigned(t < 0 ? t + base : t);
+            }
+            long long t = (long long)u[j + n] - (long long)carry - borrow;
+            if (t < 0) {
+                --qhat;
+                unsigned c = 0;
+                for (std::size_t i = 0; i < n; ++i) {
+                    unsigned e = u[i + j] + v[i] + c;
+                    c = e >= base;
+                    u[i + j] = c ? e - base : e;
+                }
+                t += c;
+            }
+            u[j + n] = unsigned(t);
+            q[j] = unsigned(qhat);
+        }
+        trim(q);
+        u.resize(n);
+        unsigned long long rem = 0;
+        for (auto i = n; i-- > 0;) {
+            rem = rem * base + u[i];
+            u[i] = unsigned(rem / d);
+            rem %= d;
+        }
+        trim(u);
+    }
+
+    // Multiplies a limb vector by m (m <= 2^32).
+    static void mul_small(std::vector<unsigned> &a, unsigned long long m) {
+        unsigned long long carry = 0;
+        for (auto &e : a) {
+            carry += e * m;
+            e = carry % base;
+            carry /= base;
+        }
+        for (; carry != 0; carry /= base) a.push_back(carry % base);
+    }
+
+    // Bit-level helpers.  Limbs are base 10^9, so there is no binary limb
+    // representation to work on directly: shifts by up to 64 bits and
+    // right shifts run as single-limb multiplications/divisions (O(n) per
+    // 32 bits), and everything that needs the actual bit pattern converts
+    // the magnitude to base-2^32 words first, which costs O(n^2).
+
+    void trim() { trim(num); }
+
+    std::size_t limb_count() const { return limb_count(num); }
+
+    int compare_abs(const unsigned *a, std::size_t m) const {
+        auto n = limb_count();
+        if (n != m) return n < m ? -1 : 1;
+        for (auto i = n; i-- > 0;)
+            if (num[i] != a[i]) return num[i] < a[i] ? -1 : 1;
+        return 0;
+    }
+
+    // Compares against a native integer without building a bigint.
+    int compare_native(bool p, unsigned long long a) const {
+        if (num.empty()) throw std::runtime_error("compare: Object is empty.");
+        unsigned t[3];
+        std::size_t m = 0;
+        do {
+            t[m++] = a % base;
+            a /= base;
+        } while (a != 0);
+        int s = is_zero() ? 0 : pos ? 1 : -1;
+        int ts = t[0] == 0 && m == 1 ? 0 : p ? 1 : -1;
+        if (s != ts) return s < ts ? -1 : 1;
+        return s * compare_abs(t, m);
+    }
+
+    // Decimal digits d[0, n) to limbs [first, last), least significant
+    // first; the digits are not checked. Limbs are independent, so ranges
+    // can be filled in parallel.
+    static void parse_limbs(const char *d, std::size_t n, unsigned *limbs,
+                            std::size_t first, std::size_t last);
+    // Writes a limb as base_len - 1 digits with leading zeros.
+    static void format_limb(unsigned e, char *out);
+
+    // Folds the limbs into T if the value fits. A T of d decimal digits
+    // spans at most d / 9 + 1 limbs, which bounds the loop.
+    template <typename T>
+    bool convert_to(T &r) const {
+        using U = typename detail::unsigned_of<T>::type;
+        const std::size_t max_limbs = std::numeric_limits<U>::digits10 / 9 + 1;
+        if (num.empty()) return false;
+        auto n = limb_count();
+        if (n > max_limbs) return false;
+        const U max = std::numeric_limits<U>::max();
+        U m = 0;
+        for (auto i = n; i-- > 0;) {
+            if (num[i] > max || m > (max - num[i]) / base) return false;
+            m = U(m * base + num[i]);
         }
+        bool neg = !pos && m != 0;
+        if (!std::numeric_limits<T>::is_signed) {
+            if (neg) return false;
+            r = T(m);
+            return true;
+        }
+        if (m > U(std::numeric_limits<T>::max()) + neg) return false;
+        r = neg ? T(-T(m - 1) - 1) : T(m);
+        return true;
+    }
+
+    template <typename T>
+    static unsigned long long magnitude(T a) {
+        return a < 0 ? 0ull - (unsigned long long)a : (unsigned long long)a;
+    }
+
+    std::size_t hash_with_sign(bool) const noexcept;
+
+    bool is_zero() const {
+        return std::all_of(num.begin(), num.end(),
+                           [](const auto &e) { return e == 0; });
+    }
+
+    void mul_small(unsigned long long m) { mul_small(num, m); }
+
+    // Divides the magnitude by d (0 < d <= 2^32) and returns the remainder.
+    unsigned long long divmod_small(unsigned long long d) {
+        unsigned long long rem = 0;
+        for (auto it = num.rbegin(); it != num.rend(); ++it) {
+            rem = rem * base + *it;
+            *it = unsigned(rem / d);
+            rem %= d;
+        }
+        trim();
+        return rem;
+    }
+
+    // Magnitude as base-2^32 words, least significant first.  O(n^2).
+    std::vector<unsigned> to_binary() const {
+        std::vector<unsigned> r;
+        bigint t(num, true);
+        t.trim();
+        while (!t.is_zero()) r.push_back(unsigned(t.divmod_small(1ull << 32)));
+        return r;
+    }
+
+    // Inverse of to_binary(), by splitting at the cached powers
+    // 2^(32 * 2^j) (see power_cache.hh).  O(M(n) log n).
+    static bigint from_binary(const std::vector<unsigned> &w, bool p);
+    static void from_binary(const unsigned *w, std::size_t n,
+                            std::vector<unsigned> &x,
+                            detail::power_cache_reader &c);
+
+    // Extends w to len words of two's complement, negating it if neg.
+    static void complement(std::vector<unsigned> &w, std::size_t len,
+                           bool neg) {
+        w.resize(len, 0);
+        if (!neg) return;
+        bool carry = true;
+        for (auto &e : w) {
+            e = ~e;
+            if (carry) carry = (++e == 0);
+        }
+    }
+
+    // 2^k as a product of cached powers.
+    static bigint pow2(unsigned long k);
+
+    bigint &lshift_a(unsigned long k) {
+        if (num.empty()) {
+            throw std::runtime_error("Operator<<=: Object is empty.");
+        }
+        BIGINT_TRACE_OP(trace_op::lshift, *this, k);
+        if (k > 64) {
+            *this *= pow2(k);
+            trim();
+            return *this;
+        }
+        for (; k >= 32; k -= 32) mul_small(1ull << 32);
+        mul_small(1ull << k);
+        return *this;
+    }
+
+    // Arithmetic shift: rounds toward negative infinity like the two's
+    // complement shift of a machine integer.
+    bigint &rshift_a(unsigned long k) {
+        if (num.empty()) {
+            throw std::runtime_error("Operator>>=: Object is empty.");
+        }
+        BIGINT_TRACE_OP(trace_op::rshift, *this, k);
+        trim();
+        bool inexact = false;
+        for (; k >= 32 && !is_zero(); k -= 32)
+            inexact |= divmod_small(1ull << 32) != 0;
+        if (k < 32 && !is_zero()) inexact |= divmod_small(1ull << k) != 0;
+        if (!pos && inexact) *this -= 1;
+        if (is_zero()) pos = true;
         return *this;
     }
+
+    // Applies op word-wise to the infinite two's complement expansions.
+    template <typename Op>
+    bigint &bitwise_a(const bigint &a, Op op) {
+        if (num.empty() || a.num.empty()) {
+            throw std::runtime_error("Bitwise operator: Object is empty.");
+        }
+        BIGINT_TRACE_OP(trace_kind(op), *this, a);
+        auto x = to_binary(), y = a.to_binary();
+        auto len = std::max(x.size(), y.size()) + 1;
+        complement(x, len, !pos && !is_zero());
+        complement(y, len, !a.pos && !a.is_zero());
+        for (std::size_t i = 0; i < len; ++i) x.at(i) = op(x.at(i), y.at(i));
+        bool neg = x.back() >> 31;
+        complement(x, len, neg);
+        return *this = from_binary(x, !neg);
+    }
 };
 
 bigint factorial(int);
 }  // namespace extypes
+
+namespace std {
+template <>
+struct hash<extypes::bigint> {
+    std::size_t operator()(const extypes::bigint &a) const noexcept {
+        return a.hash();
+    }
+};
+}  // namespace std
@@ -0,0 +1,181 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "bigint_accumulator.hh"
+
+#include <stdexcept>
+#include <utility>
+
+namespace extypes {
+
+bigint_accumulator::bigint_accumulator() : terms(0) {}
+
+bigint_accumulator &bigint_accumulator::operator+=(const bigint &a) {
+    if (a.num.empty())
+        throw std::runtime_error("Operator+=: Object is empty.");
+    add_limbs(a.num.data(), a.num.size(), !a.pos);
+    return *this;
+}
+bigint_accumulator &bigint_accumulator::operator+=(int a) {
+    add_native(a < 0 ? 0ull - a : a, a < 0);
+    return *this;
+}
+bigint_accumulator &bigint_accumulator::operator+=(unsigned a) {
+    add_native(a, false);
+    return *this;
+}
+bigint_accumulator &bigint_accumulator::operator+=(long a) {
+    add_native(a < 0 ? 0ull - a : a, a < 0);
+    return *this;
+}
+bigint_accumulator &bigint_accumulator::operator+=(unsigned long a) {
+    add_native(a, false);
+    return *this;
+}
+bigint_accumulator &bigint_accumulator::operator+=(long long a) {
+    add_native(a < 0 ? 0ull - a : a, a < 0);
+    return *this;
+}
+
+bigint_accumulator &bigint_accumulator::operator-=(const bigint &a) {
+    if (a.num.empty())
+        throw std::runtime_error("Operator-=: Object is empty.");
+    add_limbs(a.num.data(), a.num.size(), a.pos);
+    return *this;
+}
+bigint_accumulator &bigint_accumulator::operator-=(int a) {
+    add_native(a < 0 ? 0ull - a : a, a >= 0);
+    return *this;
+}
+bigint_accumulator &bigint_accumulator::operator-=(unsigned a) {
+    add_native(a, true);
+    return *this;
+}
+bigint_accumulator &bigint_accumulator::operator-=(long a) {
+    add_native(a < 0 ? 0ull - a : a, a >= 0);
+    return *this;
+}
+bigint_accumulator &bigint_accumulator::operator-=(unsigned long a) {
+    add_native(a, true);
+    return *this;
+}
+bigint_accumulator &bigint_accumulator::operator-=(long long a) {
+    add_native(a < 0 ? 0ull - a : a, a >= 0);
+    return *this;
+}
+
+bigint_accumulator &bigint_accumulator::merge(const bigint_accumulator &a) {
+    if (a.terms > 1) {
+        bigint_accumulator t(a);
+        t.normalize();
+        return merge(t);
+    }
+    // a's lanes are now below base in magnitude, like those of one term.
+    reserve_term();
+    if (lanes.size() < a.lanes.size()) lanes.resize(a.lanes.size(), 0);
+    for (std::size_t i = 0; i < a.lanes.size(); ++i) lanes[i] += a.lanes[i];
+    return *this;
+}
+
+bigint bigint_accumulator::value() const {
+    bigint_accumulator t(*this);
+    t.normalize();
+    auto &l = t.lanes;
+    bool neg = !l.empty() && l.back() < 0;
+    if (neg) l.pop_back();
+    std::vector<unsigned> m(l.size());
+    if (!neg) {
+        for (std::size_t i = 0; i < l.size(); ++i) m[i] = unsigned(l[i]);
+    } else {
+        // The lanes hold base^n - |sum|.
+        unsigned carry = 1;
+        for (std::size_t i = 0; i < l.size(); ++i) {
+            auto e = unsigned(base - 1 - l[i]) + carry;
+            carry = e >= base;
+            m[i] = carry ? unsigned(e - base) : e;
+        }
+        if (carry) m.push_back(carry);
+    }
+    while (m.size() > 1 && m.back() == 0) m.pop_back();
+    if (m.empty()) m.push_back(0);
+    bool zero = m.size() == 1 && m[0] == 0;
+    return bigint(std::move(m), !neg || zero);
+}
+
+void bigint_accumulator::clear() {
+    lanes.clear();
+    terms = 0;
+}
+
+unsigned long long bigint_accumulator::pending() const { return terms; }
+
+void bigint_accumulator::add_limbs(const unsigned *a, std::size_t n,
+                                   bool neg) {
+    reserve_term();
+    if (lanes.size() < n) lanes.resize(n, 0);
+    if (neg) {
+        for (std::size_t i = 0; i < n; ++i) lanes[i] -= a[i];
+    } else {
+        for (std::size_t i = 0; i < n; ++i) lanes[i] += a[i];
+    }
+}
+
+void bigint_accumulator::add_native(unsigned long long a, bool neg) {
+    unsigned t[3];
+    std::size_t n = 0;
+    for (; a != 0; a /= base) t[n++] = unsigned(a % base);
+    add_limbs(t, n, neg);
+}
+
+void bigint_accumulator::reserve_term() {
+    if (terms == max_terms) normalize();
+    ++terms;
+}
+
+// Brings every lane into [0, base), except that a negative sum ends in a
+// top lane of -1 standing for -base^n.
+void bigint_accumulator::normalize() {
+    long long carry = 0;
+    for (auto &e : lanes) {
+        long long v = e + carry;
+        carry = v / base;
+        v %= base;
+        if (v < 0) {
+            v += base;
+            --carry;
+        }
+        e = v;
+    }
+    while (carry != 0 && carry != -1) {
+        long long v = carry % base;
+        carry /= base;
+        if (v < 0) {
+            v += base;
+            --carry;
+        }
+        lanes.push_back(v);
+    }
+    if (carry == -1) lanes.push_back(-1);
+    while (!lanes.empty() && lanes.back() == 0) lanes.pop_back();
+    terms = lanes.empty() ? 0 : 1;
+}
+}  // namespace extypes
@@ -0,0 +1,79 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "bigint.hh"
+
+namespace extypes {
+// Running sum of bigint and native integer terms with deferred carries.
+//
+// Each lane is a signed 64-bit sum of the base-10^9 limbs added at its
+// position, so adding a term is a plain pass over its limbs with no carry
+// and no reallocation once the lanes are wide enough. Lanes are brought
+// back into [0, 10^9) only when value() is asked for or when enough terms
+// have been added that the next one could overflow a lane. Accumulators
+// filled on different threads are combined with merge().
+struct bigint_accumulator {
+    bigint_accumulator();
+
+    bigint_accumulator &operator+=(const bigint &);
+    bigint_accumulator &operator+=(int);
+    bigint_accumulator &operator+=(unsigned);
+    bigint_accumulator &operator+=(long);
+    bigint_accumulator &operator+=(unsigned long);
+    bigint_accumulator &operator+=(long long);
+
+    bigint_accumulator &operator-=(const bigint &);
+    bigint_accumulator &operator-=(int);
+    bigint_accumulator &operator-=(unsigned);
+    bigint_accumulator &operator-=(long);
+    bigint_accumulator &operator-=(unsigned long);
+    bigint_accumulator &operator-=(long long);
+
+    // Adds the sum held by another accumulator.
+    bigint_accumulator &merge(const bigint_accumulator &);
+
+    // The sum so far; the accumulator itself is left as is.
+    bigint value() const;
+    void clear();
+    // Terms added since the lanes were last normalized.
+    unsigned long long pending() const;
+
+  private:
+    std::vector<long long> lanes;
+    unsigned long long terms;
+
+    const static long long base = 1000000000;
+    // Every term moves a lane by less than base, so this many terms fit in
+    // a lane of at most base in magnitude without overflow.
+    const static unsigned long long max_terms = 9000000000ull;
+
+    void add_limbs(const unsigned *, std::size_t, bool);
+    void add_native(unsigned long long, bool);
+    void reserve_term();
+    void normalize();
+};
+}  // namespace extypes
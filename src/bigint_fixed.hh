@@ -0,0 +1,263 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "bigint.hh"
+
+namespace extypes {
+// Signed integer of at most Limbs base-10^9 limbs, stored inline.
+//
+// The limb layout is the one of bigint, so converting between the two is a
+// plain copy. Every operation is constexpr and loops over a compile-time
+// number of limbs; results that do not fit throw std::overflow_error (which
+// makes an overflowing constant expression ill-formed), and the *_overflow
+// functions report overflow without throwing.
+template <std::size_t Limbs>
+struct bigint_fixed {
+    static_assert(Limbs > 0, "bigint_fixed needs at least one limb.");
+
+    static constexpr std::size_t limbs = Limbs;
+
+    constexpr bigint_fixed() : num{}, pos(true) {}
+    template <typename T,
+              typename = std::enable_if_t<std::is_integral<T>::value>>
+    constexpr bigint_fixed(T n) : num{}, pos(true) {
+        unsigned long long m = n;
+        if constexpr (std::is_signed<T>::value) {
+            pos = n >= 0;
+            if (!pos) m = 0ull - m;
+        }
+        for (std::size_t i = 0; m != 0; ++i, m /= base) {
+            if (i == Limbs)
+                throw std::overflow_error("bigint_fixed: Overflow.");
+            num[i] = m % base;
+        }
+        if (is_zero()) pos = true;
+    }
+    // Parses a decimal literal, e.g. bigint_fixed<4>("-123456789012").
+    constexpr explicit bigint_fixed(const char *a) : num{}, pos(true) {
+        if (*a == '+' || *a == '-') pos = (*a++ == '+');
+        std::size_t len = 0;
+        while (a[len] != '\0') {
+            if (a[len] < '0' || a[len] > '9')
+                throw std::invalid_argument("Invalid argument.");
+            ++len;
+        }
+        if (len == 0) throw std::invalid_argument("Invalid argument.");
+        for (std::size_t i = 0; len != 0; ++i) {
+            unsigned l = 0, p = 1;
+            for (unsigned d = 0; d < base_len - 1 && len != 0; ++d, p *= 10)
+                l += (a[--len] - '0') * p;
+            if (l != 0 && i >= Limbs)
+                throw std::overflow_error("bigint_fixed: Overflow.");
+            if (i < Limbs) num[i] = l;
+        }
+        if (is_zero()) pos = true;
+    }
+    explicit bigint_fixed(const bigint &a) : num{}, pos(true) {
+        if (a.num.empty()) throw std::runtime_error("Object is empty.");
+        auto n = a.limb_count();
+        if (n > Limbs) throw std::overflow_error("bigint_fixed: Overflow.");
+        for (std::size_t i = 0; i < n; ++i) num[i] = a.num[i];
+        pos = a.pos || is_zero();
+    }
+
+    bigint to_bigint() const {
+        auto n = size();
+        return bigint(std::vector<unsigned>(num, num + n), pos);
+    }
+    std::string to_string() const { return to_bigint().to_string(); }
+    friend std::ostream &operator<<(std::ostream &os, const bigint_fixed &a) {
+        return os << a.to_string();
+    }
+
+    constexpr bool sign() const { return pos; }
+    constexpr bigint_fixed abs() const {
+        bigint_fixed r(*this);
+        r.pos = true;
+        return r;
+    }
+    constexpr unsigned operator[](std::size_t i) const { return num[i]; }
+    // Number of limbs in use, at least one.
+    constexpr std::size_t size() const {
+        auto n = Limbs;
+        while (n > 1 && num[n - 1] == 0) --n;
+        return n;
+    }
+
+    constexpr int compare(const bigint_fixed &a) const {
+        int s = is_zero() ? 0 : pos ? 1 : -1;
+        int as = a.is_zero() ? 0 : a.pos ? 1 : -1;
+        if (s != as) return s < as ? -1 : 1;
+        return s * compare_abs(a);
+    }
+
+    // Store a op b in r and return whether the exact result did not fit.
+    static constexpr bool add_overflow(const bigint_fixed &a,
+                                       const bigint_fixed &b,
+                                       bigint_fixed &r) {
+        return add_signed(a, b, b.pos, r);
+    }
+    static constexpr bool sub_overflow(const bigint_fixed &a,
+                                       const bigint_fixed &b,
+                                       bigint_fixed &r) {
+        return add_signed(a, b, !b.pos, r);
+    }
+    static constexpr bool mul_overflow(const bigint_fixed &a,
+                                       const bigint_fixed &b,
+                                       bigint_fixed &r) {
+        unsigned t[2 * Limbs] = {};
+        for (std::size_t i = 0; i < Limbs; ++i) {
+            if (a.num[i] == 0) continue;
+            unsigned long long carry = 0;
+            for (std::size_t j = 0; j < Limbs; ++j) {
+                carry += t[i + j] + (unsigned long long)a.num[i] * b.num[j];
+                t[i + j] = carry % base;
+                carry /= base;
+            }
+            t[i + Limbs] = unsigned(carry);
+        }
+        bool overflow = false;
+        for (std::size_t i = 0; i < Limbs; ++i) {
+            r.num[i] = t[i];
+            overflow |= t[i + Limbs] != 0;
+        }
+        r.pos = (a.pos == b.pos) || r.is_zero();
+        return overflow;
+    }
+
+    constexpr bigint_fixed operator+() const { return *this; }
+    constexpr bigint_fixed operator-() const {
+        bigint_fixed r(*this);
+        r.pos = !pos || is_zero();
+        return r;
+    }
+
+    constexpr bigint_fixed &operator+=(const bigint_fixed &a) {
+        if (add_overflow(*this, a, *this))
+            throw std::overflow_error("bigint_fixed: Overflow.");
+        return *this;
+    }
+    constexpr bigint_fixed &operator-=(const bigint_fixed &a) {
+        if (sub_overflow(*this, a, *this))
+            throw std::overflow_error("bigint_fixed: Overflow.");
+        return *this;
+    }
+    constexpr bigint_fixed &operator*=(const bigint_fixed &a) {
+        if (mul_overflow(*this, a, *this))
+            throw std::overflow_error("bigint_fixed: Overflow.");
+        return *this;
+    }
+
+    friend constexpr bigint_fixed operator+(bigint_fixed a,
+                                            const bigint_fixed &b) {
+        return a += b;
+    }
+    friend constexpr bigint_fixed operator-(bigint_fixed a,
+                                            const bigint_fixed &b) {
+        return a -= b;
+    }
+    friend constexpr bigint_fixed operator*(bigint_fixed a,
+                                            const bigint_fixed &b) {
+        return a *= b;
+    }
+
+    friend constexpr bool operator==(const bigint_fixed &a,
+                                     const bigint_fixed &b) {
+        return a.compare(b) == 0;
+    }
+    friend constexpr bool operator!=(const bigint_fixed &a,
+                                     const bigint_fixed &b) {
+        return a.compare(b) != 0;
+    }
+    friend constexpr bool operator<(const bigint_fixed &a,
+                                    const bigint_fixed &b) {
+        return a.compare(b) < 0;
+    }
+    friend constexpr bool operator>(const bigint_fixed &a,
+                                    const bigint_fixed &b) {
+        return a.compare(b) > 0;
+    }
+    friend constexpr bool operator<=(const bigint_fixed &a,
+                                     const bigint_fixed &b) {
+        return a.compare(b) <= 0;
+    }
+    friend constexpr bool operator>=(const bigint_fixed &a,
+                                     const bigint_fixed &b) {
+        return a.compare(b) >= 0;
+    }
+
+  private:
+    unsigned num[Limbs];
+    bool pos;
+    const static unsigned base = 1000000000;
+    const static unsigned short base_len = 10;
+
+    constexpr bool is_zero() const {
+        for (std::size_t i = 0; i < Limbs; ++i)
+            if (num[i] != 0) return false;
+        return true;
+    }
+
+    constexpr int compare_abs(const bigint_fixed &a) const {
+        for (auto i = Limbs; i-- > 0;)
+            if (num[i] != a.num[i]) return num[i] < a.num[i] ? -1 : 1;
+        return 0;
+    }
+
+    // r = a + (bp ? |b| : -|b|); r may alias a or b.
+    static constexpr bool add_signed(const bigint_fixed &a,
+                                     const bigint_fixed &b, bool bp,
+                                     bigint_fixed &r) {
+        if (a.pos == bp) {
+            unsigned carry = 0;
+            for (std::size_t i = 0; i < Limbs; ++i) {
+                unsigned e = a.num[i] + b.num[i] + carry;
+                carry = e >= base;
+                r.num[i] = carry ? e - base : e;
+            }
+            r.pos = bp || r.is_zero();
+            return carry != 0;
+        }
+        bool rev = a.compare_abs(b) < 0;
+        const bigint_fixed &x = rev ? b : a;
+        const bigint_fixed &y = rev ? a : b;
+        bool p = rev ? bp : a.pos;
+        unsigned borrow = 0;
+        for (std::size_t i = 0; i < Limbs; ++i) {
+            unsigned s = y.num[i] + borrow;
+            borrow = x.num[i] < s;
+            r.num[i] = borrow ? x.num[i] + base - s : x.num[i] - s;
+        }
+        r.pos = p || r.is_zero();
+        return false;
+    }
+};
+}  // namespace extypes
@@ -0,0 +1,224 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "bigrational.hh"
+
+namespace extypes {
+
+bigrational::bigrational() : n(0), d(1), reduced_limbs(2), canonical(true) {}
+bigrational::bigrational(int a)
+    : n(a), d(1), reduced_limbs(0), canonical(true) {
+    reduced_limbs = limbs();
+}
+bigrational::bigrational(long a)
+    : n(a), d(1), reduced_limbs(0), canonical(true) {
+    reduced_limbs = limbs();
+}
+bigrational::bigrational(long long a)
+    : n(a), d(1), reduced_limbs(0), canonical(true) {
+    reduced_limbs = limbs();
+}
+bigrational::bigrational(const bigint &a)
+    : n(a), d(1), reduced_limbs(0), canonical(true) {
+    reduced_limbs = limbs();
+}
+bigrational::bigrational(const bigint &a, const bigint &b)
+    : n(a), d(b), reduced_limbs(0), canonical(false) {
+    if (d == 0) throw std::runtime_error("Division by zero");
+    if (!d.sign()) {
+        d.pos = true;
+        n.pos = !n.pos || n.is_zero();
+    }
+    canonical = d == 1;
+    reduced_limbs = limbs();
+}
+bigrational::bigrational(const bigrational &a)
+    : n(a.n), d(a.d), reduced_limbs(a.reduced_limbs), canonical(a.canonical) {
+}
+
+const bigint &bigrational::numerator() const { return n; }
+const bigint &bigrational::denominator() const { return d; }
+bool bigrational::sign() const { return n.sign(); }
+bool bigrational::is_integer() const { return d == 1; }
+bool bigrational::is_canonical() const { return canonical; }
+bigrational &bigrational::canonicalize() {
+    if (canonical) return *this;
+    if (n.is_zero()) {
+        d = 1;
+    } else {
+        bigint g = gcd(n, d);
+        if (g != 1) {
+            n /= g;
+            d /= g;
+        }
+    }
+    canonical = true;
+    reduced_limbs = limbs();
+    return *this;
+}
+
+std::string bigrational::to_string() const {
+    bigrational t(*this);
+    t.canonicalize();
+    if (t.d == 1) return t.n.to_string();
+    return t.n.to_string() + "/" + t.d.to_string();
+}
+std::ostream &operator<<(std::ostream &os, const bigrational &a) {
+    return os << a.to_string();
+}
+
+bigrational bigrational::operator+() const { return *this; }
+bigrational bigrational::operator-() const {
+    bigrational t(*this);
+    t.n.pos = !t.n.pos || t.n.is_zero();
+    return t;
+}
+
+bigrational &bigrational::operator+=(const bigrational &a) {
+    add_a(a, true);
+    return *this;
+}
+bigrational &bigrational::operator-=(const bigrational &a) {
+    add_a(a, false);
+    return *this;
+}
+bigrational &bigrational::operator*=(const bigrational &a) {
+    if (a.d == 1) {
+        n *= a.n;
+    } else if (d == 1) {
+        n *= a.n;
+        d = a.d;
+    } else {
+        n *= a.n;
+        d *= a.d;
+    }
+    changed();
+    return *this;
+}
+bigrational &bigrational::operator/=(const bigrational &a) {
+    if (a.n == 0) throw std::runtime_error("Division by zero");
+    bool p = a.n.sign();
+    if (this == &a) return *this = bigrational(1);
+    n *= a.d;
+    d *= a.n;
+    if (!p) {
+        d.pos = true;
+        n.pos = !n.pos || n.is_zero();
+    }
+    changed();
+    return *this;
+}
+
+bigrational bigrational::operator+(const bigrational &a) const {
+    bigrational t(*this);
+    return t += a;
+}
+bigrational bigrational::operator-(const bigrational &a) const {
+    bigrational t(*this);
+    return t -= a;
+}
+bigrational bigrational::operator*(const bigrational &a) const {
+    bigrational t(*this);
+    return t *= a;
+}
+bigrational bigrational::operator/(const bigrational &a) const {
+    bigrational t(*this);
+    return t /= a;
+}
+
+bigrational &bigrational::operator=(const bigrational &a) {
+    n = a.n;
+    d = a.d;
+    reduced_limbs = a.reduced_limbs;
+    canonical = a.canonical;
+    return *this;
+}
+
+int bigrational::compare(const bigrational &a) const {
+    // Signs decide most comparisons; otherwise cross-multiply, which needs
+    // no gcd and works on unreduced values.
+    int s = n.is_zero() ? 0 : n.sign() ? 1 : -1;
+    int as = a.n.is_zero() ? 0 : a.n.sign() ? 1 : -1;
+    if (s != as || s == 0) return s < as ? -1 : s > as ? 1 : 0;
+    if (d == a.d) return n.compare(a.n);
+    thread_local bigint l, r;
+    mul(l, n, a.d);
+    mul(r, a.n, d);
+    return l.compare(r);
+}
+bool bigrational::operator==(const bigrational &a) const {
+    if (canonical && a.canonical) return n == a.n && d == a.d;
+    return compare(a) == 0;
+}
+bool bigrational::operator!=(const bigrational &a) const {
+    return !(*this == a);
+}
+bool bigrational::operator<(const bigrational &a) const {
+    return compare(a) < 0;
+}
+bool bigrational::operator>(const bigrational &a) const {
+    return compare(a) > 0;
+}
+bool bigrational::operator<=(const bigrational &a) const {
+    return compare(a) <= 0;
+}
+bool bigrational::operator>=(const bigrational &a) const {
+    return compare(a) >= 0;
+}
+
+void bigrational::changed() {
+    canonical = d == 1;
+    if (canonical) reduced_limbs = limbs();
+    else if (limbs() > 2 * reduced_limbs + growth_slack)
+        canonicalize();
+}
+std::size_t bigrational::limbs() const {
+    return n.limb_count() + d.limb_count();
+}
+void bigrational::add_a(const bigrational &a, bool plus) {
+    if (this == &a) {
+        bigrational t(a);
+        return add_a(t, plus);
+    }
+    if (d == a.d) {
+        // Common denominator, which includes both being integers.
+        plus ? add(n, n, a.n) : sub(n, n, a.n);
+    } else if (a.d == 1) {
+        plus ? addmul(n, a.n, d) : submul(n, a.n, d);
+    } else if (d == 1) {
+        thread_local bigint t;
+        t = n;
+        n = a.n;
+        if (!plus) n.pos = !n.pos || n.is_zero();
+        addmul(n, t, a.d);
+        d = a.d;
+    } else {
+        thread_local bigint t;
+        mul(t, a.n, d);
+        n *= a.d;
+        plus ? add(n, n, t) : sub(n, n, t);
+        d *= a.d;
+    }
+    changed();
+}
+
+}  // namespace extypes
@@ -0,0 +1,93 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+#include "bigint.hh"
+
+namespace extypes {
+// Exact rational number over bigint.
+//
+// Reduction by the gcd is deferred: results are only brought to lowest
+// terms when the numerator and denominator have grown well past their size
+// at the last reduction, or when canonicalize() is called. The denominator
+// is always positive, so the sign lives in the numerator.
+struct bigrational {
+    bigrational();
+    bigrational(int);
+    bigrational(long);
+    bigrational(long long);
+    bigrational(const bigint &);
+    bigrational(const bigint &, const bigint &);
+    bigrational(const bigrational &);
+
+    const bigint &numerator() const;
+    const bigint &denominator() const;
+    bool sign() const;
+    bool is_integer() const;
+    bool is_canonical() const;
+    bigrational &canonicalize();
+
+    std::string to_string() const;
+    friend std::ostream &operator<<(std::ostream &, const bigrational &);
+
+    bigrational operator+() const;
+    bigrational operator-() const;
+
+    bigrational &operator+=(const bigrational &);
+    bigrational &operator-=(const bigrational &);
+    bigrational &operator*=(const bigrational &);
+    bigrational &operator/=(const bigrational &);
+
+    bigrational operator+(const bigrational &) const;
+    bigrational operator-(const bigrational &) const;
+    bigrational operator*(const bigrational &) const;
+    bigrational operator/(const bigrational &) const;
+
+    bigrational &operator=(const bigrational &);
+
+    int compare(const bigrational &) const;
+    bool operator==(const bigrational &) const;
+    bool operator!=(const bigrational &) const;
+    bool operator<(const bigrational &) const;
+    bool operator>(const bigrational &) const;
+    bool operator<=(const bigrational &) const;
+    bool operator>=(const bigrational &) const;
+
+  private:
+    bigint n, d;
+    // Limbs of n and d after the last reduction, and whether nothing has
+    // happened since.
+    std::size_t reduced_limbs;
+    bool canonical;
+    // Extra limbs tolerated on top of twice the reduced size.
+    const static std::size_t growth_slack = 4;
+
+    void changed();
+    std::size_t limbs() const;
+    void add_a(const bigrational &, bool);
+};
+}  // namespace extypes
@@ -0,0 +1,133 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "combinatorics.hh"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "parallel.hh"
+#include "product_tree.hh"
+
+namespace extypes {
+
+namespace {
+// Primes per task when computing exponents.
+const std::size_t exponent_block = 4096;
+
+// Primes up to n, by a sieve of Eratosthenes over the odd numbers.
+std::vector<unsigned long> primes_upto(unsigned long n) {
+    std::vector<unsigned long> ps;
+    if (n < 2) return ps;
+    ps.push_back(2);
+    // composite[i] stands for 2i + 1.
+    std::vector<char> composite(n / 2 + 1, 0);
+    for (unsigned long i = 1; i <= (n - 1) / 2; ++i) {
+        if (composite[i]) continue;
+        unsigned long p = 2 * i + 1;
+        ps.push_back(p);
+        if (p > n / p) continue;
+        for (unsigned long j = p * p / 2; j <= (n - 1) / 2; j += p)
+            composite[j] = 1;
+    }
+    return ps;
+}
+
+// Exponent of p in n!.
+unsigned long legendre(unsigned long n, unsigned long p) {
+    unsigned long e = 0;
+    while (n != 0) e += (n /= p);
+    return e;
+}
+
+// Product of p^e over the primes below n + 1, e being the exponent of p in
+// n! / (k_1! ... k_m!). With P_j the product of the primes whose exponent
+// has bit j set, this is P_0 * P_1^2 * P_2^4 * ..., evaluated from the top
+// bit down by squaring; the power of two is applied as a shift.
+bigint from_exponents(unsigned long n, const std::vector<unsigned long> &ks,
+                      unsigned threads) {
+    auto ps = primes_upto(n);
+    std::vector<unsigned long> es(ps.size());
+    auto blocks = (ps.size() + exponent_block - 1) / exponent_block;
+    detail::parallel_for(blocks, threads, [&](std::size_t b) {
+        auto last = std::min(ps.size(), (b + 1) * exponent_block);
+        for (auto i = b * exponent_block; i < last; ++i) {
+            auto e = legendre(n, ps[i]);
+            for (auto k : ks)
+                if (k >= ps[i]) e -= legendre(k, ps[i]);
+            es[i] = e;
+        }
+    });
+
+    // Primes of one group are packed into words before building the trees.
+    const auto word_max = std::numeric_limits<unsigned long>::max();
+    std::vector<std::vector<bigint>> groups;
+    std::vector<unsigned long> words;
+    for (std::size_t i = 1; i < ps.size(); ++i) {
+        for (unsigned j = 0; es[i] >> j != 0; ++j) {
+            if ((es[i] >> j & 1) == 0) continue;
+            if (j >= words.size()) {
+                words.resize(j + 1, 1);
+                groups.resize(j + 1);
+            }
+            if (words[j] > word_max / ps[i]) {
+                groups[j].emplace_back(words[j]);
+                words[j] = 1;
+            }
+            words[j] *= ps[i];
+        }
+    }
+    bigint r = 1;
+    for (auto j = groups.size(); j-- > 0;) {
+        if (words[j] != 1) groups[j].emplace_back(words[j]);
+        r *= r;
+        r *= product(groups[j], threads);
+    }
+    if (!es.empty()) r <<= es[0];
+    return r;
+}
+}  // namespace
+
+bigint binomial(unsigned long n, unsigned long k, unsigned threads) {
+    if (k > n) return 0;
+    k = std::min(k, n - k);
+    if (k == 0) return 1;
+    return from_exponents(n, {k, n - k}, threads);
+}
+
+bigint multinomial(const std::vector<unsigned long> &ks, unsigned threads) {
+    unsigned long n = 0;
+    for (auto k : ks) {
+        if (k > std::numeric_limits<unsigned long>::max() - n) {
+            throw std::overflow_error("multinomial: Overflow.");
+        }
+        n += k;
+    }
+    return from_exponents(n, ks, threads);
+}
+
+bigint factorial(int n) {
+    if (n < 0) throw std::invalid_argument("Invalid argument.");
+    return from_exponents((unsigned long)n, {}, 0);
+}
+}  // namespace extypes
@@ -0,0 +1,42 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <vector>
+
+#include "bigint.hh"
+
+namespace extypes {
+// Binomial and multinomial coefficients without any big division: the
+// exponent of every prime p <= n in the result follows from Legendre's
+// formula, and the prime powers are multiplied together with product trees
+// on up to `threads` threads (0 means std::thread::hardware_concurrency()).
+// factorial(int), declared in bigint.hh, is built the same way.
+
+// n choose k, 0 if k > n.
+bigint binomial(unsigned long n, unsigned long k, unsigned threads = 0);
+// (k_1 + ... + k_m)! / (k_1! ... k_m!); throws std::overflow_error if the
+// sum does not fit in an unsigned long.
+bigint multinomial(const std::vector<unsigned long> &ks,
+                   unsigned threads = 0);
+}  // namespace extypes
@@ -0,0 +1,180 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "decimal_io.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define BIGINT_HAVE_MMAP 1
+#endif
+
+#include "parallel.hh"
+
+namespace extypes {
+
+namespace {
+// Limbs handled by one task, and limbs per output chunk.
+const std::size_t block_limbs = 1 << 14;
+const std::size_t chunk_limbs = 1 << 17;
+
+// Read-only view of a whole file: a private mapping where mmap is
+// available, otherwise a copy in memory.
+class file_view {
+  public:
+    explicit file_view(const std::string &path) {
+#ifdef BIGINT_HAVE_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) fail(path);
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            fail(path);
+        }
+        n = std::size_t(st.st_size);
+        if (n != 0) {
+            void *p = ::mmap(nullptr, n, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                fail(path);
+            }
+            ::madvise(p, n, MADV_SEQUENTIAL);
+            d = static_cast<const char *>(p);
+        }
+        ::close(fd);
+#else
+        std::ifstream is(path, std::ios::binary);
+        if (!is) fail(path);
+        copy.assign(std::istreambuf_iterator<char>(is),
+                    std::istreambuf_iterator<char>());
+        d = copy.data();
+        n = copy.size();
+#endif
+    }
+    ~file_view() {
+#ifdef BIGINT_HAVE_MMAP
+        if (n != 0) ::munmap(const_cast<char *>(d), n);
+#endif
+    }
+    file_view(const file_view &) = delete;
+    file_view &operator=(const file_view &) = delete;
+
+    const char *data() const { return d; }
+    std::size_t size() const { return n; }
+
+  private:
+    const char *d = nullptr;
+    std::size_t n = 0;
+#ifndef BIGINT_HAVE_MMAP
+    std::string copy;
+#endif
+
+    [[noreturn]] static void fail(const std::string &path) {
+        throw std::runtime_error("read_decimal: Cannot read " + path + ".");
+    }
+};
+
+bool space(char c) { return std::isspace((unsigned char)c) != 0; }
+}  // namespace
+
+bigint read_decimal(const std::string &path, unsigned threads) {
+    file_view f(path);
+    const char *d = f.data(), *end = d + f.size();
+    while (d != end && space(*d)) ++d;
+    while (end != d && space(end[-1])) --end;
+    bigint r;
+    if (d != end && (*d == '+' || *d == '-')) r.pos = (*d++ == '+');
+    auto n = std::size_t(end - d);
+    if (n == 0) throw std::invalid_argument("Invalid argument.");
+
+    const std::size_t w = bigint::base_len - 1;
+    r.num.resize((n + w - 1) / w);
+    auto blocks = (r.num.size() + block_limbs - 1) / block_limbs;
+    std::atomic<bool> valid(true);
+    detail::parallel_for(blocks, threads, [&](std::size_t b) {
+        auto first = b * block_limbs,
+             last = std::min(first + block_limbs, r.num.size());
+        auto dl = n - std::min(n, w * last), dh = n - w * first;
+        if (!std::all_of(d + dl, d + dh,
+                         [](char c) { return c >= '0' && c <= '9'; }))
+            valid = false;
+        else
+            bigint::parse_limbs(d, n, r.num.data(), first, last);
+    });
+    if (!valid) throw std::invalid_argument("Invalid argument.");
+    r.trim();
+    if (r.is_zero()) r.pos = true;
+    return r;
+}
+
+void write_decimal(const std::string &path, const bigint &a,
+                   unsigned threads) {
+    if (a.num.empty()) {
+        throw std::runtime_error("write_decimal: Object is empty.");
+    }
+    std::unique_ptr<std::FILE, int (*)(std::FILE *)> f(
+        std::fopen(path.c_str(), "wb"), std::fclose);
+    if (!f) {
+        throw std::runtime_error("write_decimal: Cannot write " + path + ".");
+    }
+    auto fail = [&] {
+        throw std::runtime_error("write_decimal: Cannot write " + path + ".");
+    };
+
+    const std::size_t w = bigint::base_len - 1;
+    auto n = a.limb_count();
+    char head[16];
+    int len = std::snprintf(head, sizeof head, "%s%u",
+                            !a.pos && !a.is_zero() ? "-" : "",
+                            a.num.at(n - 1));
+    if (std::fwrite(head, 1, std::size_t(len), f.get()) != std::size_t(len))
+        fail();
+    // Limbs n - 2 down to 0, most significant first, chunk by chunk.
+    std::vector<char> buf(std::min(n - 1, chunk_limbs) * w);
+    for (auto top = n - 1; top != 0;) {
+        auto count = std::min(top, chunk_limbs);
+        auto blocks = (count + block_limbs - 1) / block_limbs;
+        detail::parallel_for(blocks, threads, [&](std::size_t b) {
+            auto first = b * block_limbs,
+                 last = std::min(first + block_limbs, count);
+            for (auto k = first; k < last; ++k)
+                bigint::format_limb(a.num[top - 1 - k], buf.data() + k * w);
+        });
+        if (std::fwrite(buf.data(), 1, count * w, f.get()) != count * w)
+            fail();
+        top -= count;
+    }
+    if (std::fputc('\n', f.get()) == EOF || std::fclose(f.release()) != 0)
+        fail();
+}
+}  // namespace extypes
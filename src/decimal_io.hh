@@ -0,0 +1,40 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <string>
+
+#include "bigint.hh"
+
+namespace extypes {
+// Decimal files of any size. read_decimal maps the file into memory and
+// parses the limbs straight from the mapping; write_decimal formats the
+// limbs into a buffer of bounded size and writes it out chunk by chunk.
+// Limbs are independent in both directions, so each chunk is converted on
+// up to `threads` threads (0 means std::thread::hardware_concurrency()).
+// Surrounding whitespace is skipped when reading, and the output ends with
+// a newline.
+bigint read_decimal(const std::string &path, unsigned threads = 0);
+void write_decimal(const std::string &path, const bigint &,
+                   unsigned threads = 0);
+}  // namespace extypes
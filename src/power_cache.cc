@@ -0,0 +1,122 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "power_cache.hh"
+
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace extypes {
+
+namespace {
+// 2^(32 * 2^47) would not fit in memory anyway.
+const std::size_t max_levels = 48;
+
+std::atomic<const bigint *> entries[max_levels];
+std::atomic<std::size_t> cache_limit(std::size_t(16) << 20);
+std::atomic<std::size_t> cache_size(0);
+// Writers serialize on fill_mutex. Readers register in readers[epoch & 1];
+// clear_power_cache() unpublishes the entries, flips the epoch and waits
+// for the readers of the old epoch before freeing anything. Clears hold
+// clear_mutex throughout, so the epoch cannot move on during the wait and
+// every reader of an unpublished entry sits in the slot being waited for.
+std::mutex fill_mutex;
+std::mutex clear_mutex;
+std::atomic<unsigned> epoch(0);
+std::atomic<std::size_t> readers[2];
+
+// Upper bound of the limb storage of entry i.
+std::size_t entry_bytes(std::size_t i) {
+    double bits = 32.0 * std::ldexp(1.0, int(i));
+    return (std::size_t(bits * std::log10(2.0) / 9) + 2) * sizeof(unsigned);
+}
+
+bigint square(const bigint &a) {
+    bigint r;
+    mul(r, a, a);
+    return r;
+}
+}  // namespace
+
+void warm_power_cache(std::size_t bits) {
+    detail::power_cache_reader c;
+    for (std::size_t i = 0; i < max_levels && (32ull << i) <= bits; ++i)
+        c.binary_power(i);
+}
+
+void clear_power_cache() {
+    std::lock_guard<std::mutex> clear_lock(clear_mutex);
+    std::vector<std::unique_ptr<const bigint>> old;
+    unsigned e;
+    {
+        std::lock_guard<std::mutex> lock(fill_mutex);
+        for (auto &p : entries) old.emplace_back(p.exchange(nullptr));
+        cache_size = 0;
+        e = epoch++;
+    }
+    while (readers[e & 1] != 0) std::this_thread::yield();
+}
+
+void set_power_cache_limit(std::size_t bytes) { cache_limit = bytes; }
+
+std::size_t power_cache_size() { return cache_size; }
+
+namespace detail {
+power_cache_reader::power_cache_reader() {
+    // A clear_power_cache() that flips the epoch between the load and the
+    // increment does not wait for this slot, so look again and move to
+    // the current slot if it has.
+    for (;;) {
+        slot = epoch & 1;
+        ++readers[slot];
+        if ((epoch & 1) == slot) break;
+        --readers[slot];
+    }
+}
+power_cache_reader::~power_cache_reader() { --readers[slot]; }
+
+const bigint &power_cache_reader::binary_power(std::size_t i) {
+    auto next = [&] {
+        return i == 0 ? bigint(4294967296LL) : square(binary_power(i - 1));
+    };
+    if (i < max_levels) {
+        if (auto p = entries[i].load()) return *p;
+        if (cache_size + entry_bytes(i) <= cache_limit) {
+            auto r = std::make_unique<const bigint>(next());
+            std::lock_guard<std::mutex> lock(fill_mutex);
+            if (auto p = entries[i].load()) return *p;
+            if (cache_size + entry_bytes(i) <= cache_limit) {
+                cache_size += entry_bytes(i);
+                entries[i] = r.get();
+                return *r.release();
+            }
+        }
+    }
+    if (local.size() <= i) local.resize(i + 1);
+    if (!local.at(i)) local.at(i) = std::make_unique<const bigint>(next());
+    return *local.at(i);
+}
+}  // namespace detail
+}  // namespace extypes
@@ -0,0 +1,67 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "bigint.hh"
+
+namespace extypes {
+// Process-wide cache of the powers 2^(32 * 2^i) that shifts and the
+// conversions between base-10^9 limbs and binary words are built from.
+//
+// Entries are computed on first use, each by squaring the previous one,
+// and are shared by all threads. Lookups of filled entries only read an
+// atomic pointer. Entries that would take the cache past its memory limit
+// are not stored; readers that need them compute private copies.
+
+// Fills every entry up to 2^bits, within the limit.
+void warm_power_cache(std::size_t bits);
+// Frees all entries. Readers still using an entry are waited for.
+void clear_power_cache();
+// Bytes of limb storage the cache may hold (16 MiB by default). Lowering
+// it does not evict entries; call clear_power_cache() for that.
+void set_power_cache_limit(std::size_t bytes);
+// Bytes of limb storage held.
+std::size_t power_cache_size();
+
+namespace detail {
+// Keeps the entries it hands out alive until it is destroyed.
+class power_cache_reader {
+  public:
+    power_cache_reader();
+    ~power_cache_reader();
+    power_cache_reader(const power_cache_reader &) = delete;
+    power_cache_reader &operator=(const power_cache_reader &) = delete;
+
+    // 2^(32 * 2^i).
+    const bigint &binary_power(std::size_t i);
+
+  private:
+    unsigned slot;
+    std::vector<std::unique_ptr<const bigint>> local;
+};
+}  // namespace detail
+}  // namespace extypes
@@ -0,0 +1,342 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "prime.hh"
+
+#include <algorithm>
+#include <random>
+
+#include "parallel.hh"
+
+namespace extypes {
+
+namespace {
+// Single tests trial-divide by the odd primes below trial_limit; range
+// sieves use every prime below sieve_limit.
+const unsigned trial_limit = 1000;
+const unsigned sieve_limit = 65536;
+// Range sieves work through segments of this many numbers.
+const unsigned long segment_size = 1 << 16;
+
+const std::vector<unsigned> &sieve_primes() {
+    static const std::vector<unsigned> r = [] {
+        std::vector<unsigned> ps;
+        std::vector<char> composite(sieve_limit, 0);
+        for (unsigned i = 2; i < sieve_limit; ++i) {
+            if (composite.at(i)) continue;
+            ps.push_back(i);
+            for (unsigned j = i * i; j < sieve_limit; j += i)
+                composite.at(j) = 1;
+        }
+        return ps;
+    }();
+    return r;
+}
+
+// Runs of consecutive odd primes below trial_limit whose product fits in
+// 32 bits, so one single-limb remainder pass covers the whole run.
+struct prime_group {
+    unsigned product;
+    std::size_t first, last;
+};
+const std::vector<prime_group> &trial_groups() {
+    static const std::vector<prime_group> r = [] {
+        std::vector<prime_group> gs;
+        const auto &ps = sieve_primes();
+        for (std::size_t i = 1; i < ps.size() && ps.at(i) < trial_limit;) {
+            prime_group g{1, i, i};
+            while (g.last < ps.size() && ps.at(g.last) < trial_limit &&
+                   (unsigned long long)g.product * ps.at(g.last) <= UINT_MAX)
+                g.product *= ps.at(g.last++);
+            gs.push_back(g);
+            i = g.last;
+        }
+        return gs;
+    }();
+    return r;
+}
+
+enum class verdict { composite, prime, unknown };
+
+// n >= 2.
+verdict trial_division(const bigint &n) {
+    if (n.remainder(2) == 0)
+        return n == 2 ? verdict::prime : verdict::composite;
+    const auto &ps = sieve_primes();
+    for (const auto &g : trial_groups()) {
+        unsigned r = n.remainder(g.product);
+        for (auto i = g.first; i < g.last; ++i)
+            if (r % ps.at(i) == 0)
+                return n == ps.at(i) ? verdict::prime : verdict::composite;
+    }
+    if (n < trial_limit * trial_limit) return verdict::prime;
+    return verdict::unknown;
+}
+
+void mulmod(bigint &r, const bigint &a, const bigint &b, const bigint &m) {
+    thread_local bigint t, q;
+    mul(t, a, b);
+    divmod(q, r, t, m);
+}
+
+// Bits of a positive number, most significant first.
+std::vector<bool> to_bits(bigint a) {
+    std::vector<bool> r;
+    while (a != 0) {
+        unsigned w = a.remainder(65536);
+        for (int i = 0; i < 16; ++i) r.push_back((w >> i) & 1);
+        a >>= 16;
+    }
+    while (!r.empty() && !r.back()) r.pop_back();
+    std::reverse(r.begin(), r.end());
+    return r;
+}
+
+bigint powmod(const bigint &a, const std::vector<bool> &e, const bigint &m) {
+    bigint r = 1;
+    for (bool b : e) {
+        mulmod(r, r, r, m);
+        if (b) mulmod(r, r, a, m);
+    }
+    return r;
+}
+
+// n - 1 = d * 2^s with d odd; a in [2, n - 2].
+bool strong_probable_prime(const bigint &n, const bigint &nm1,
+                           const std::vector<bool> &d, unsigned s,
+                           const bigint &a) {
+    bigint x = powmod(a, d, n);
+    if (x == 1 || x == nm1) return true;
+    for (unsigned i = 1; i < s; ++i) {
+        mulmod(x, x, x, n);
+        if (x == nm1) return true;
+        if (x == 1) return false;
+    }
+    return false;
+}
+
+// Jacobi symbol (a/n) for odd a and odd n > 0.
+int jacobi(long a, const bigint &n) {
+    int j = 1;
+    unsigned long m = a < 0 ? -a : a;
+    if (a < 0 && n.remainder(4) == 3) j = -j;
+    if (m % 4 == 3 && n.remainder(4) == 3) j = -j;
+    unsigned long x = n.remainder(m), y = m;
+    while (x != 0) {
+        for (; x % 2 == 0; x /= 2)
+            if (y % 8 == 3 || y % 8 == 5) j = -j;
+        std::swap(x, y);
+        if (x % 4 == 3 && y % 4 == 3) j = -j;
+        x %= y;
+    }
+    return y == 1 ? j : 0;
+}
+
+bool is_square(const bigint &n) {
+    bigint x = bigint(1) << ((n.bit_length() + 1) / 2);
+    for (;;) {
+        bigint y = (x + n / x) >> 1;
+        if (y >= x) break;
+        x = y;
+    }
+    return x * x == n;
+}
+
+// Halves a residue modulo odd n.
+void halve(bigint &x, const bigint &n) {
+    if (x.remainder(2) != 0) x += n;
+    x >>= 1;
+    if (x >= n) x -= n;
+}
+
+// Strong Lucas probable prime test with Selfridge's parameters.
+bool strong_lucas_probable_prime(const bigint &n) {
+    long d = 5;
+    for (int i = 0;; ++i, d = d > 0 ? -(d + 2) : 2 - d) {
+        int j = jacobi(d, n);
+        if (j == -1) break;
+        if (j == 0) return false;
+        if (i == 8 && is_square(n)) return false;
+    }
+    long q = (1 - d) / 4;
+    bigint dm = bigint(d) % n, qm = bigint(q) % n;
+    if (dm < 0) dm += n;
+    if (qm < 0) qm += n;
+
+    bigint k = n + 1;
+    unsigned s = 0;
+    for (; k.remainder(2) == 0; ++s) k >>= 1;
+    auto bits = to_bits(k);
+
+    // P = 1: U_1 = 1, V_1 = 1.
+    bigint u = 1, v = 1, qk = qm, t;
+    for (std::size_t i = 1; i < bits.size(); ++i) {
+        mulmod(u, u, v, n);
+        mulmod(v, v, v, n);
+        v -= qk;
+        v -= qk;
+        while (v < 0) v += n;
+        mulmod(qk, qk, qk, n);
+        if (bits.at(i)) {
+            mulmod(t, dm, u, n);
+            u += v;
+            halve(u, n);
+            v += t;
+            halve(v, n);
+            mulmod(qk, qk, qm, n);
+        }
+    }
+    if (u == 0 || v == 0) return true;
+    for (unsigned r = 1; r < s; ++r) {
+        mulmod(v, v, v, n);
+        v -= qk;
+        v -= qk;
+        while (v < 0) v += n;
+        if (v == 0) return true;
+        mulmod(qk, qk, qk, n);
+    }
+    return false;
+}
+
+// The tests after trial division; n is odd and above trial_limit^2.
+bool probable_prime_tail(const bigint &n, int rounds) {
+    bigint nm1 = n - 1, d = nm1;
+    unsigned s = 0;
+    for (; d.remainder(2) == 0; ++s) d >>= 1;
+    auto dbits = to_bits(d);
+    if (!strong_probable_prime(n, nm1, dbits, s, 2)) return false;
+
+    std::mt19937_64 rng(n.hash());
+    bigint range = n - 3;
+    auto limbs = n.digits() / 9 + 1;
+    for (int i = 1; i < rounds; ++i) {
+        bigint a = 0;
+        for (std::size_t j = 0; j < limbs; ++j) {
+            a *= 1000000000;
+            a += (unsigned)(rng() % 1000000000);
+        }
+        a = a % range + 2;
+        if (!strong_probable_prime(n, nm1, dbits, s, a)) return false;
+    }
+    return strong_lucas_probable_prime(n);
+}
+}  // namespace
+
+bool is_probable_prime(const bigint &n, int rounds) {
+    if (n < 2) return false;
+    auto v = trial_division(n);
+    if (v != verdict::unknown) return v == verdict::prime;
+    return probable_prime_tail(n, rounds);
+}
+
+bigint next_prime(const bigint &a, int rounds) {
+    if (a < 2) return 2;
+    bigint c = a + 1;
+    if (c.remainder(2) == 0) c += 1;
+    if (c < trial_limit * trial_limit) {
+        while (!is_probable_prime(c, rounds)) c += 2;
+        return c;
+    }
+    // Residues of c modulo the small primes are computed once, then
+    // advanced with the candidate, so sieving a candidate costs no
+    // bigint arithmetic at all.
+    const auto &ps = sieve_primes();
+    std::vector<unsigned> res;
+    for (const auto &g : trial_groups()) {
+        unsigned r = c.remainder(g.product);
+        for (auto i = g.first; i < g.last; ++i) res.push_back(r % ps.at(i));
+    }
+    for (unsigned long step = 0;; step += 2) {
+        bool survivor = true;
+        for (std::size_t i = 0; i < res.size() && survivor; ++i)
+            survivor = (res.at(i) + step) % ps.at(i + 1) != 0;
+        if (!survivor) continue;
+        bigint x = c + step;
+        if (probable_prime_tail(x, rounds)) return x;
+    }
+}
+
+std::vector<bool> are_probable_primes(const std::vector<bigint> &a,
+                                      int rounds, unsigned threads) {
+    std::vector<char> r(a.size(), 0);
+    std::vector<std::size_t> survivors;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a.at(i) < 2) continue;
+        auto v = trial_division(a.at(i));
+        if (v == verdict::unknown) survivors.push_back(i);
+        else
+            r.at(i) = v == verdict::prime;
+    }
+    detail::parallel_for(survivors.size(), threads, [&](std::size_t i) {
+        auto k = survivors.at(i);
+        r.at(k) = probable_prime_tail(a.at(k), rounds);
+    });
+    return std::vector<bool>(r.begin(), r.end());
+}
+
+std::vector<bigint> probable_primes_in_range(const bigint &lo,
+                                             const bigint &hi, int rounds,
+                                             unsigned threads) {
+    bigint start = lo < 2 ? bigint(2) : lo;
+    if (hi < start) return {};
+    // Below sieve_limit the start fits in an unsigned, which lets the
+    // sieve skip the small primes themselves.
+    unsigned long small_start = start < sieve_limit ? (unsigned long)start : 0;
+    const auto &ps = sieve_primes();
+    // Offset of the next multiple of each prime from the current segment.
+    std::vector<unsigned long> next(ps.size());
+    for (std::size_t k = 0; k < ps.size(); ++k) {
+        unsigned long p = ps.at(k), m = start.remainder(ps.at(k));
+        next.at(k) = m == 0 ? 0 : p - m;
+        if (small_start != 0 && small_start + next.at(k) == p) next.at(k) += p;
+    }
+    // Every composite below sieve_limit^2 is struck out by the sieve.
+    const bigint sieved = (long long)sieve_limit * sieve_limit;
+
+    std::vector<bigint> r;
+    std::vector<char> composite, prime;
+    std::vector<unsigned long> survivors;
+    for (bigint seg = start; seg <= hi; seg += segment_size) {
+        bigint rest = hi - seg;
+        unsigned long width =
+            rest < segment_size ? (unsigned long)rest + 1 : segment_size;
+        composite.assign(width, 0);
+        for (std::size_t k = 0; k < ps.size(); ++k) {
+            auto &i = next.at(k);
+            for (; i < width; i += ps.at(k)) composite.at(i) = 1;
+            i -= width;
+        }
+        survivors.clear();
+        for (unsigned long i = 0; i < width; ++i)
+            if (!composite.at(i)) survivors.push_back(i);
+        prime.assign(survivors.size(), 0);
+        detail::parallel_for(survivors.size(), threads, [&](std::size_t i) {
+            bigint x = seg + survivors.at(i);
+            prime.at(i) = x < sieved || probable_prime_tail(x, rounds);
+        });
+        for (std::size_t i = 0; i < survivors.size(); ++i)
+            if (prime.at(i)) r.push_back(seg + survivors.at(i));
+    }
+    return r;
+}
+
+}  // namespace extypes
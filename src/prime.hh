@@ -0,0 +1,46 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <vector>
+
+#include "bigint.hh"
+
+namespace extypes {
+// Baillie-PSW: trial division by small primes, a base-2 strong probable
+// prime test, rounds - 1 further Miller-Rabin rounds with pseudo-random
+// bases and a strong Lucas test.
+bool is_probable_prime(const bigint &, int rounds = 4);
+
+// Smallest probable prime greater than the argument.
+bigint next_prime(const bigint &, int rounds = 4);
+
+// Batch forms. Small-prime sieving runs first, and the survivors are tested
+// on up to `threads` threads (0 means std::thread::hardware_concurrency()).
+std::vector<bool> are_probable_primes(const std::vector<bigint> &,
+                                      int rounds = 4, unsigned threads = 0);
+// Probable primes p with lo <= p <= hi, in increasing order.
+std::vector<bigint> probable_primes_in_range(const bigint &lo,
+                                             const bigint &hi, int rounds = 4,
+                                             unsigned threads = 0);
+}  // namespace extypes
@@ -0,0 +1,85 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "product_tree.hh"
+
+#include <utility>
+
+#include "parallel.hh"
+
+namespace extypes {
+
+product_tree::product_tree() : levels(1) {}
+product_tree::product_tree(std::vector<bigint> factors, unsigned threads) {
+    levels.push_back(std::move(factors));
+    while (levels.back().size() > 1) {
+        const auto &prev = levels.back();
+        std::vector<bigint> next((prev.size() + 1) / 2);
+        detail::parallel_for(next.size(), threads, [&](std::size_t i) {
+            if (2 * i + 1 < prev.size())
+                mul(next.at(i), prev.at(2 * i), prev.at(2 * i + 1));
+            else
+                next.at(i) = prev.at(2 * i);
+        });
+        levels.push_back(std::move(next));
+    }
+}
+
+std::size_t product_tree::size() const { return levels.front().size(); }
+std::size_t product_tree::height() const { return levels.size(); }
+const std::vector<bigint> &product_tree::level(std::size_t k) const {
+    return levels.at(k);
+}
+const bigint &product_tree::product() const {
+    static const bigint one(1);
+    return size() == 0 ? one : levels.back().front();
+}
+
+std::vector<bigint> product_tree::remainders(const bigint &x,
+                                             unsigned threads) const {
+    if (size() == 0) return {};
+    std::vector<bigint> cur(1);
+    bigint q;
+    divmod(q, cur.front(), x, product());
+    for (auto k = levels.size() - 1; k-- > 0;) {
+        const auto &nodes = levels.at(k);
+        std::vector<bigint> next(nodes.size());
+        detail::parallel_for(next.size(), threads, [&](std::size_t i) {
+            thread_local bigint t;
+            divmod(t, next.at(i), cur.at(i / 2), nodes.at(i));
+        });
+        cur.swap(next);
+    }
+    return cur;
+}
+
+bigint product(const std::vector<bigint> &factors, unsigned threads) {
+    if (factors.empty()) return bigint(1);
+    return product_tree(factors, threads).product();
+}
+
+std::vector<bigint> remainder_tree(const bigint &x,
+                                   const std::vector<bigint> &moduli,
+                                   unsigned threads) {
+    return product_tree(moduli, threads).remainders(x, threads);
+}
+}  // namespace extypes
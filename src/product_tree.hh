@@ -0,0 +1,69 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "bigint.hh"
+
+namespace extypes {
+// Balanced binary tree of partial products over a list of factors.
+//
+// Level 0 holds the factors, and every node of level k + 1 is the product
+// of two neighbouring nodes of level k (an odd node out is carried up as
+// is), so the root is the product of all factors. Operands at each level
+// have similar sizes, which keeps the multiplications on the Karatsuba
+// path. Nodes of one level are independent and are computed on up to
+// `threads` threads (0 means std::thread::hardware_concurrency()).
+struct product_tree {
+    product_tree();
+    explicit product_tree(std::vector<bigint> factors, unsigned threads = 0);
+
+    // Number of factors.
+    std::size_t size() const;
+    std::size_t height() const;
+    const std::vector<bigint> &level(std::size_t) const;
+    // Product of all factors, 1 for an empty tree.
+    const bigint &product() const;
+
+    // x % f for every factor f, in order, with the sign of x like
+    // operator%. x is reduced once by the root and the remainders are
+    // pushed down the tree, so each division only sees operands about
+    // twice the size of its divisor.
+    std::vector<bigint> remainders(const bigint &x,
+                                   unsigned threads = 0) const;
+
+  private:
+    std::vector<std::vector<bigint>> levels;
+};
+
+// Product of the factors by a product tree.
+bigint product(const std::vector<bigint> &factors, unsigned threads = 0);
+
+// x % m for every modulus m, by a product tree over the moduli. Build a
+// product_tree once instead when the same moduli are reused.
+std::vector<bigint> remainder_tree(const bigint &x,
+                                   const std::vector<bigint> &moduli,
+                                   unsigned threads = 0);
+}  // namespace extypes
@@ -0,0 +1,213 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "recurrence.hh"
+
+#include <climits>
+#include <stdexcept>
+#include <utility>
+
+namespace extypes {
+
+namespace {
+// x mod m in [0, m), or x itself without a modulus.
+void reduce(bigint &x, const bigint *m) {
+    if (m == nullptr) return;
+    x %= *m;
+    if (!x.sign()) x += *m;
+}
+
+const bigint *check_modulus(const bigint &m) {
+    if (!(m > 0)) throw std::invalid_argument("Invalid argument.");
+    return &m;
+}
+
+// (F(k - 1), F(k)) for k = n >> shift, from the top bit of n down. With
+// a = F(k)^2 and b = F(k - 1)^2:
+//   F(2k + 1) = 4a - b + 2(-1)^k, F(2k - 1) = a + b,
+//   F(2k) = F(2k + 1) - F(2k - 1).
+std::pair<bigint, bigint> fibonacci_pair(unsigned long n, unsigned shift,
+                                         const bigint *m) {
+    bigint f0 = 1, f1 = 0, a, b;
+    unsigned long k = 0;
+    for (auto i = sizeof n * CHAR_BIT; i-- > shift;) {
+        if (k != 0) {
+            mul(a, f1, f1);
+            mul(b, f0, f0);
+            reduce(a, m);
+            reduce(b, m);
+            // f0 = F(2k - 1), f1 = F(2k + 1)
+            add(f0, a, b);
+            a += a;
+            a += a;
+            a -= b;
+            a += k % 2 ? -2 : 2;
+            f1 = std::move(a);
+            reduce(f1, m);
+            reduce(f0, m);
+            k *= 2;
+            if (n >> i & 1) {
+                // (F(2k), F(2k + 1))
+                sub(f0, f1, f0);
+                ++k;
+            } else {
+                // (F(2k - 1), F(2k))
+                sub(f1, f1, f0);
+            }
+            reduce(f0, m);
+            reduce(f1, m);
+        } else if (n >> i & 1) {
+            f0 = 0;
+            f1 = 1;
+            k = 1;
+        }
+    }
+    return {std::move(f0), std::move(f1)};
+}
+
+// F(n), with the last doubling step done by a single multiplication:
+//   F(2k) = F(k) (F(k) + 2F(k - 1)),
+//   F(2k + 1) = (2F(k) + F(k - 1)) (2F(k) - F(k - 1)) + 2(-1)^k.
+bigint fibonacci_of(unsigned long n, const bigint *m) {
+    auto f = fibonacci_pair(n, 1, m);
+    bigint r;
+    if (n % 2 == 0) {
+        bigint t = f.first + f.first;
+        t += f.second;
+        mul(r, f.second, t);
+    } else {
+        bigint t = f.second + f.second, u = t - f.first;
+        t += f.first;
+        mul(r, t, u);
+        r += n / 2 % 2 ? -2 : 2;
+    }
+    reduce(r, m);
+    return r;
+}
+
+// L(n) = F(n) + 2F(n - 1).
+bigint lucas_of(unsigned long n, const bigint *m) {
+    auto f = fibonacci_pair(n, 0, m);
+    bigint r = f.first + f.first;
+    r += f.second;
+    reduce(r, m);
+    return r;
+}
+
+// Polynomials of degree below k, reduced modulo the characteristic
+// polynomial x^k - c_0 x^(k-1) - ... - c_(k-1).
+class recurrence_ring {
+  public:
+    recurrence_ring(const std::vector<bigint> &coefficients, const bigint *mod)
+        : c(coefficients), m(mod) {}
+
+    // p = p * p.
+    void square(std::vector<bigint> &p) const {
+        auto k = c.size();
+        std::vector<bigint> r(2 * k - 1, bigint(0));
+        for (std::size_t i = 0; i < k; ++i)
+            for (std::size_t j = i + 1; j < k; ++j)
+                addmul(r[i + j], p[i], p[j]);
+        for (auto &e : r) e += e;
+        for (std::size_t i = 0; i < k; ++i) addmul(r[2 * i], p[i], p[i]);
+        for (auto &e : r) reduce(e, m);
+        fold(r);
+        p = std::move(r);
+    }
+    // p = p * x.
+    void shift(std::vector<bigint> &p) const {
+        p.insert(p.begin(), bigint(0));
+        fold(p);
+    }
+
+  private:
+    const std::vector<bigint> &c;
+    const bigint *m;
+
+    // Replaces x^d by c_0 x^(d-1) + ... + c_(k-1) x^(d-k) for d >= k, from
+    // the top, and truncates p to k coefficients.
+    void fold(std::vector<bigint> &p) const {
+        auto k = c.size();
+        for (auto d = p.size(); d-- > k;) {
+            for (std::size_t j = 0; j < k; ++j) {
+                addmul(p[d - 1 - j], p[d], c[j]);
+                reduce(p[d - 1 - j], m);
+            }
+        }
+        p.resize(k);
+    }
+};
+
+bigint recurrence_of(const std::vector<bigint> &c,
+                     const std::vector<bigint> &initial, unsigned long n,
+                     const bigint *m) {
+    auto k = c.size();
+    if (k == 0 || initial.size() != k) {
+        throw std::invalid_argument("Invalid argument.");
+    }
+    bigint r;
+    if (n < k) {
+        r = initial[n];
+        reduce(r, m);
+        return r;
+    }
+    // p = x^n modulo the characteristic polynomial, so that
+    // a_n = p_0 a_0 + ... + p_(k-1) a_(k-1).
+    recurrence_ring ring(c, m);
+    std::vector<bigint> p(k, bigint(0));
+    p[0] = 1;
+    // Start at the top set bit of n (n >= k > 0): before it p stays 1, and
+    // each square would be a wasted k x k product.
+    auto top = sizeof n * CHAR_BIT - 1;
+    while ((n >> top & 1) == 0) --top;
+    ring.shift(p);
+    for (auto i = top; i-- > 0;) {
+        ring.square(p);
+        if (n >> i & 1) ring.shift(p);
+    }
+    r = 0;
+    for (std::size_t i = 0; i < k; ++i) addmul(r, p[i], initial[i]);
+    reduce(r, m);
+    return r;
+}
+}  // namespace
+
+bigint fibonacci(unsigned long n) { return fibonacci_of(n, nullptr); }
+bigint fibonacci(unsigned long n, const bigint &m) {
+    return fibonacci_of(n, check_modulus(m));
+}
+bigint lucas(unsigned long n) { return lucas_of(n, nullptr); }
+bigint lucas(unsigned long n, const bigint &m) {
+    return lucas_of(n, check_modulus(m));
+}
+
+bigint linear_recurrence(const std::vector<bigint> &c,
+                         const std::vector<bigint> &initial,
+                         unsigned long n) {
+    return recurrence_of(c, initial, n, nullptr);
+}
+bigint linear_recurrence(const std::vector<bigint> &c,
+                         const std::vector<bigint> &initial, unsigned long n,
+                         const bigint &m) {
+    return recurrence_of(c, initial, n, check_modulus(m));
+}
+}  // namespace extypes
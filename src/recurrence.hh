@@ -0,0 +1,52 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <vector>
+
+#include "bigint.hh"
+
+namespace extypes {
+// Terms of linear recurrences in O(log n) big multiplications.
+//
+// fibonacci and lucas double the index with two squarings per bit of n;
+// linear_recurrence computes x^n modulo the characteristic polynomial by
+// repeated squaring (Kitamasa's method) and combines the initial terms
+// with its coefficients. The overloads taking a modulus m > 0 reduce every
+// intermediate value with operator% and return a value in [0, m); they
+// throw std::invalid_argument if m is not positive.
+
+bigint fibonacci(unsigned long n);
+bigint fibonacci(unsigned long n, const bigint &m);
+bigint lucas(unsigned long n);
+bigint lucas(unsigned long n, const bigint &m);
+
+// a_n of a_i = c_0 a_(i-1) + c_1 a_(i-2) + ... + c_(k-1) a_(i-k), with
+// initial terms a_0, ..., a_(k-1). Throws std::invalid_argument unless
+// 0 < k == initial.size().
+bigint linear_recurrence(const std::vector<bigint> &c,
+                         const std::vector<bigint> &initial, unsigned long n);
+bigint linear_recurrence(const std::vector<bigint> &c,
+                         const std::vector<bigint> &initial, unsigned long n,
+                         const bigint &m);
+}  // namespace extypes
@@ -0,0 +1,221 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "shared_bigint.hh"
+
+#include <atomic>
+#include <stdexcept>
+#include <utility>
+
+namespace extypes {
+
+// Storage of every NaN handle; never unique, so never written to or freed.
+shared_bigint::storage *shared_bigint::nan_storage() {
+    static auto nan = new storage(bigint());
+    return nan;
+}
+shared_bigint::storage::storage(bigint v) : value(std::move(v)), refs(1) {}
+
+shared_bigint::shared_bigint() : shared_bigint(nan_storage(), true) {}
+shared_bigint::shared_bigint(int n) : shared_bigint(bigint(n)) {}
+shared_bigint::shared_bigint(long n) : shared_bigint(bigint(n)) {}
+shared_bigint::shared_bigint(long long n) : shared_bigint(bigint(n)) {}
+shared_bigint::shared_bigint(bigint a) : pos(a.pos || a.is_zero()) {
+    a.pos = true;
+    p = new storage(std::move(a));
+}
+shared_bigint::shared_bigint(const shared_bigint &a)
+    : shared_bigint(a.p, a.pos) {}
+shared_bigint::shared_bigint(shared_bigint &&a) noexcept
+    : p(a.p), pos(a.pos) {
+    a.p = nan_storage();
+    a.p->refs.fetch_add(1, std::memory_order_relaxed);
+    a.pos = true;
+}
+shared_bigint::shared_bigint(storage *q, bool s)
+    : p(q), pos(s || q->value.is_zero()) {
+    p->refs.fetch_add(1, std::memory_order_relaxed);
+}
+shared_bigint::~shared_bigint() { release(); }
+shared_bigint &shared_bigint::operator=(shared_bigint a) noexcept {
+    std::swap(p, a.p);
+    std::swap(pos, a.pos);
+    return *this;
+}
+
+// The acq_rel decrement and the acquire load in owned() order every read
+// a handle made before it was dropped ahead of writes by the last owner.
+void shared_bigint::release() {
+    if (p->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete p;
+}
+bool shared_bigint::owned() const {
+    return p->refs.load(std::memory_order_acquire) == 1;
+}
+
+bool shared_bigint::sign() const { return pos; }
+const bigint &shared_bigint::magnitude() const { return p->value; }
+long shared_bigint::use_count() const {
+    return p->refs.load(std::memory_order_relaxed);
+}
+
+bigint shared_bigint::value() const & {
+    bigint r(p->value);
+    r.pos = pos;
+    return r;
+}
+bigint shared_bigint::value() && {
+    bigint r = owned() ? std::move(p->value) : bigint(p->value);
+    r.pos = pos;
+    *this = shared_bigint();
+    return r;
+}
+
+shared_bigint shared_bigint::abs() const { return shared_bigint(p, true); }
+shared_bigint shared_bigint::operator+() const { return *this; }
+shared_bigint shared_bigint::operator-() const {
+    return shared_bigint(p, !pos);
+}
+
+// Applies f(r, |a|, sign of a) to the signed value r of *this, in place if
+// this handle owns its storage alone and on a private copy otherwise.
+template <typename F>
+shared_bigint &shared_bigint::update(const shared_bigint &a, F f) {
+    shared_bigint b(a);
+    if (!owned()) {
+        auto q = new storage(p->value);
+        release();
+        p = q;
+    }
+    p->value.pos = pos;
+    try {
+        f(p->value, b.p->value, b.pos);
+    } catch (...) {
+        p->value.pos = true;
+        throw;
+    }
+    pos = p->value.pos || p->value.is_zero();
+    p->value.pos = true;
+    return *this;
+}
+
+shared_bigint &shared_bigint::operator+=(const shared_bigint &a) {
+    return update(a, [](bigint &r, const bigint &m, bool s) {
+        if (s)
+            r += m;
+        else
+            r -= m;
+    });
+}
+shared_bigint &shared_bigint::operator-=(const shared_bigint &a) {
+    return update(a, [](bigint &r, const bigint &m, bool s) {
+        if (s)
+            r -= m;
+        else
+            r += m;
+    });
+}
+shared_bigint &shared_bigint::operator*=(const shared_bigint &a) {
+    return update(a, [](bigint &r, const bigint &m, bool s) {
+        r *= m;
+        if (!s) r.pos = !r.pos;
+    });
+}
+shared_bigint &shared_bigint::operator/=(const shared_bigint &a) {
+    return update(a, [](bigint &r, const bigint &m, bool s) {
+        r /= m;
+        if (!s) r.pos = !r.pos;
+    });
+}
+shared_bigint &shared_bigint::operator%=(const shared_bigint &a) {
+    return update(a, [](bigint &r, const bigint &m, bool) { r %= m; });
+}
+
+bigint shared_bigint::add_signed(const shared_bigint &a,
+                                 const shared_bigint &b, bool bp) {
+    const bigint &x = a.p->value, &y = b.p->value;
+    if (a.pos != bp) return a.pos ? x - y : y - x;
+    bigint r = x + y;
+    r.pos = a.pos;
+    return r;
+}
+shared_bigint shared_bigint::with_sign(bigint m, bool s) {
+    shared_bigint r(std::move(m));
+    r.pos = s || r.p->value.is_zero();
+    return r;
+}
+shared_bigint operator+(const shared_bigint &a, const shared_bigint &b) {
+    return shared_bigint::add_signed(a, b, b.pos);
+}
+shared_bigint operator-(const shared_bigint &a, const shared_bigint &b) {
+    return shared_bigint::add_signed(a, b, !b.pos);
+}
+shared_bigint operator*(const shared_bigint &a, const shared_bigint &b) {
+    return shared_bigint::with_sign(a.p->value * b.p->value, a.pos == b.pos);
+}
+shared_bigint operator/(const shared_bigint &a, const shared_bigint &b) {
+    return shared_bigint::with_sign(a.p->value / b.p->value, a.pos == b.pos);
+}
+shared_bigint operator%(const shared_bigint &a, const shared_bigint &b) {
+    return shared_bigint::with_sign(a.p->value % b.p->value, a.pos);
+}
+
+int shared_bigint::compare(const shared_bigint &a) const {
+    if (p->value.num.empty() || a.p->value.num.empty()) {
+        throw std::runtime_error("compare: Object is empty.");
+    }
+    int s = p->value.is_zero() ? 0 : pos ? 1 : -1;
+    int as = a.p->value.is_zero() ? 0 : a.pos ? 1 : -1;
+    if (s != as) return s < as ? -1 : 1;
+    const bigint &x = p->value, &y = a.p->value;
+    return s * x.compare_abs(y.num.data(), y.limb_count());
+}
+bool shared_bigint::operator==(const shared_bigint &a) const {
+    return compare(a) == 0;
+}
+bool shared_bigint::operator!=(const shared_bigint &a) const {
+    return compare(a) != 0;
+}
+bool shared_bigint::operator<(const shared_bigint &a) const {
+    return compare(a) < 0;
+}
+bool shared_bigint::operator>(const shared_bigint &a) const {
+    return compare(a) > 0;
+}
+bool shared_bigint::operator<=(const shared_bigint &a) const {
+    return compare(a) <= 0;
+}
+bool shared_bigint::operator>=(const shared_bigint &a) const {
+    return compare(a) >= 0;
+}
+
+std::size_t shared_bigint::hash() const noexcept {
+    return p->value.hash_with_sign(pos);
+}
+std::string shared_bigint::to_string() const {
+    return pos ? p->value.to_string() : "-" + p->value.to_string();
+}
+std::ostream &operator<<(std::ostream &os, const shared_bigint &a) {
+    if (os.width() != 0) return os << a.to_string();
+    if (!a.pos) os << '-';
+    return os << a.p->value;
+}
+}  // namespace extypes
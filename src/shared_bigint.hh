@@ -0,0 +1,133 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <string>
+
+#include "bigint.hh"
+
+namespace extypes {
+// Immutable bigint handle with shared, reference-counted limbs.
+//
+// Copying a handle, abs(), unary plus and unary minus are O(1): the handles
+// share one stored magnitude and only their sign flags differ. Arithmetic
+// reads the shared magnitudes directly and returns a new handle. The
+// storage is cloned only on mutation, i.e. when a compound assignment or
+// std::move(h).value() meets storage that other handles still refer to;
+// a sole owner is updated in place. Handles may be copied and read from
+// any number of threads.
+struct shared_bigint {
+    shared_bigint();
+    shared_bigint(int);
+    shared_bigint(long);
+    shared_bigint(long long);
+    // Pass an rvalue to adopt the limbs without copying.
+    shared_bigint(bigint);
+    shared_bigint(const shared_bigint &);
+    // Leaves the source NaN.
+    shared_bigint(shared_bigint &&) noexcept;
+    ~shared_bigint();
+    shared_bigint &operator=(shared_bigint) noexcept;
+
+    bool sign() const;
+    // |*this|, shared with every handle onto the same storage.
+    const bigint &magnitude() const;
+    // Number of handles sharing the storage.
+    long use_count() const;
+    // The value as a plain bigint; the rvalue overload moves the limbs out
+    // when this handle is the sole owner and leaves it NaN.
+    bigint value() const &;
+    bigint value() &&;
+
+    shared_bigint abs() const;
+    shared_bigint operator+() const;
+    shared_bigint operator-() const;
+
+    shared_bigint &operator+=(const shared_bigint &);
+    shared_bigint &operator-=(const shared_bigint &);
+    shared_bigint &operator*=(const shared_bigint &);
+    shared_bigint &operator/=(const shared_bigint &);
+    shared_bigint &operator%=(const shared_bigint &);
+
+    friend shared_bigint operator+(const shared_bigint &,
+                                   const shared_bigint &);
+    friend shared_bigint operator-(const shared_bigint &,
+                                   const shared_bigint &);
+    friend shared_bigint operator*(const shared_bigint &,
+                                   const shared_bigint &);
+    friend shared_bigint operator/(const shared_bigint &,
+                                   const shared_bigint &);
+    friend shared_bigint operator%(const shared_bigint &,
+                                   const shared_bigint &);
+
+    int compare(const shared_bigint &) const;
+    bool operator==(const shared_bigint &) const;
+    bool operator!=(const shared_bigint &) const;
+    bool operator<(const shared_bigint &) const;
+    bool operator>(const shared_bigint &) const;
+    bool operator<=(const shared_bigint &) const;
+    bool operator>=(const shared_bigint &) const;
+
+    // Equal to value().hash().
+    std::size_t hash() const noexcept;
+    std::string to_string() const;
+    friend std::ostream &operator<<(std::ostream &, const shared_bigint &);
+
+  private:
+    // Limbs and the number of handles sharing them.
+    struct storage {
+        explicit storage(bigint);
+        bigint value;
+        std::atomic<long> refs;
+    };
+
+    storage *p;
+    bool pos;
+
+    shared_bigint(storage *, bool);
+    static storage *nan_storage();
+    void release();
+    // Whether this handle is the only one sharing the storage.
+    bool owned() const;
+    // Signed sum of the magnitudes, ap|a| + bp|b|.
+    static bigint add_signed(const shared_bigint &, const shared_bigint &,
+                             bool);
+    // The handle of s ? m : -m for a magnitude m.
+    static shared_bigint with_sign(bigint, bool);
+    template <typename F>
+    shared_bigint &update(const shared_bigint &, F);
+};
+}  // namespace extypes
+
+namespace std {
+template <>
+struct hash<extypes::shared_bigint> {
+    std::size_t operator()(const extypes::shared_bigint &a) const noexcept {
+        return a.hash();
+    }
+};
+}  // namespace std
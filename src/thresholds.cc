@@ -0,0 +1,122 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "thresholds.hh"
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef BIGINT_THRESHOLDS_HEADER
+#include BIGINT_THRESHOLDS_HEADER
+#endif
+#ifndef BIGINT_KARATSUBA_THRESHOLD
+#define BIGINT_KARATSUBA_THRESHOLD 40
+#endif
+#ifndef BIGINT_BINARY_SPLIT_THRESHOLD
+#define BIGINT_BINARY_SPLIT_THRESHOLD 32
+#endif
+
+namespace extypes {
+
+namespace detail {
+std::atomic<std::size_t> karatsuba_threshold(BIGINT_KARATSUBA_THRESHOLD);
+std::atomic<std::size_t> binary_split_threshold(
+    BIGINT_BINARY_SPLIT_THRESHOLD);
+}  // namespace detail
+
+namespace {
+// Reads `path` into t, keeping absent names.
+void parse_thresholds(const std::string &path, thresholds &t) {
+    std::ifstream is(path);
+    if (!is) {
+        throw std::runtime_error("load_thresholds: Cannot read " + path +
+                                 ".");
+    }
+    std::string line;
+    while (std::getline(is, line)) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream ls(line);
+        std::string name, rest;
+        long long v;
+        if (!(ls >> name)) continue;
+        if (!(ls >> v) || v < 0 || (ls >> rest))
+            throw std::invalid_argument("Invalid argument.");
+        if (name == "karatsuba")
+            t.karatsuba = std::size_t(v);
+        else if (name == "binary_split")
+            t.binary_split = std::size_t(v);
+        else
+            throw std::invalid_argument("Invalid argument.");
+    }
+}
+
+// Applies $BIGINT_THRESHOLDS before main; a missing or bad file leaves the
+// defaults in place.
+const bool environment_loaded = [] {
+    if (const char *path = std::getenv("BIGINT_THRESHOLDS")) {
+        try {
+            load_thresholds(path);
+        } catch (const std::exception &) {
+            return false;
+        }
+    }
+    return true;
+}();
+}  // namespace
+
+thresholds default_thresholds() {
+    return {BIGINT_KARATSUBA_THRESHOLD, BIGINT_BINARY_SPLIT_THRESHOLD};
+}
+thresholds get_thresholds() {
+    return {detail::karatsuba_threshold.load(std::memory_order_relaxed),
+            detail::binary_split_threshold.load(std::memory_order_relaxed)};
+}
+void set_thresholds(const thresholds &t) {
+    if (t.karatsuba < 4 || t.binary_split < 1)
+        throw std::invalid_argument("Invalid argument.");
+    detail::karatsuba_threshold.store(t.karatsuba, std::memory_order_relaxed);
+    detail::binary_split_threshold.store(t.binary_split,
+                                         std::memory_order_relaxed);
+}
+
+thresholds load_thresholds(const std::string &path) {
+    auto t = get_thresholds();
+    parse_thresholds(path, t);
+    set_thresholds(t);
+    return t;
+}
+void save_thresholds(std::ostream &os, const thresholds &t) {
+    os << "karatsuba " << t.karatsuba << "\nbinary_split " << t.binary_split
+       << "\n";
+}
+
+void save_thresholds(const std::string &path, const thresholds &t) {
+    std::ofstream os(path);
+    save_thresholds(os, t);
+    if (!os.flush()) {
+        throw std::runtime_error("save_thresholds: Cannot write " + path +
+                                 ".");
+    }
+}
+}  // namespace extypes
@@ -0,0 +1,67 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+namespace extypes {
+// Crossover points between algorithm tiers.
+//
+// The defaults are compiled in, from the header named by the CMake cache
+// variable BIGINT_THRESHOLDS_HEADER when set and built-in values otherwise.
+// At startup, the file named by the BIGINT_THRESHOLDS environment variable
+// is loaded over them if it exists and is valid. bigint_tune measures the
+// crossovers on the host and writes either form.
+struct thresholds {
+    // Limbs of the smaller factor from which multiplication uses Karatsuba
+    // (at least 4, below which the middle product would not shrink).
+    std::size_t karatsuba;
+    // Binary words above which the conversion from binary splits at a
+    // cached power of two instead of using Horner's rule (at least 1).
+    std::size_t binary_split;
+};
+
+// The compiled-in defaults.
+thresholds default_thresholds();
+thresholds get_thresholds();
+// Throws std::invalid_argument for values below the minimums.
+void set_thresholds(const thresholds &);
+
+// Files hold one "name value" line per threshold, with the names
+// karatsuba and binary_split; '#' starts a comment and absent names keep
+// their current value. load_thresholds applies the file and returns the
+// resulting thresholds; it throws std::runtime_error if the file cannot be
+// read and std::invalid_argument if it is malformed.
+thresholds load_thresholds(const std::string &path);
+void save_thresholds(const std::string &path, const thresholds &);
+// Writes the file format to os; the caller checks the stream state.
+void save_thresholds(std::ostream &os, const thresholds &);
+
+namespace detail {
+extern std::atomic<std::size_t> karatsuba_threshold;
+extern std::atomic<std::size_t> binary_split_threshold;
+}  // namespace detail
+}  // namespace extypes
@@ -0,0 +1,170 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "trace.hh"
+
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+
+#include "bigint.hh"
+
+namespace extypes {
+
+// File layout, in native byte order: the 8-byte magic, a 32-bit version
+// and a 32-bit flag word (bit 0: values present), then one record per
+// operation: op and sign bits (one byte each), la and lb (32 bits each)
+// and, with values, la limbs of a followed by lb limbs of b (none for
+// shifts).
+
+namespace {
+const char trace_magic[8] = {'B', 'I', 'G', 'T', 'R', 'A', 'C', 'E'};
+const std::uint32_t trace_version = 1;
+const std::uint32_t flag_values = 1;
+const unsigned op_count = unsigned(trace_op::bit_xor) + 1;
+
+std::atomic<bool> trace_active(false);
+std::mutex trace_mutex;
+std::ofstream trace_file;
+bool trace_values = false;
+thread_local unsigned trace_depth = 0;
+
+template <typename T>
+void put(const T &a) {
+    trace_file.write(reinterpret_cast<const char *>(&a), sizeof a);
+}
+
+template <typename T>
+void get(std::istream &is, T &a) {
+    if (!is.read(reinterpret_cast<char *>(&a), sizeof a))
+        throw std::runtime_error("read_trace: Truncated trace.");
+}
+
+void get_limbs(std::istream &is, std::vector<unsigned> &a, std::uint32_t n) {
+    a.resize(n);
+    if (!is.read(reinterpret_cast<char *>(a.data()), n * sizeof(unsigned)))
+        throw std::runtime_error("read_trace: Truncated trace.");
+}
+}  // namespace
+
+const char *to_string(trace_op op) {
+    static const char *names[op_count] = {
+        "add", "sub", "mul", "divmod", "lshift", "rshift", "and", "or", "xor",
+    };
+    return names[unsigned(op)];
+}
+
+void start_trace(const std::string &path, bool values) {
+#ifndef BIGINT_TRACE
+    (void)path;
+    (void)values;
+    throw std::runtime_error("start_trace: Built without BIGINT_TRACE.");
+#else
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    if (trace_file.is_open()) trace_file.close();
+    trace_file.open(path, std::ios::binary | std::ios::trunc);
+    if (!trace_file)
+        throw std::runtime_error("start_trace: Cannot open " + path + ".");
+    trace_values = values;
+    trace_file.write(trace_magic, sizeof trace_magic);
+    put(trace_version);
+    put(values ? flag_values : 0u);
+    trace_active = true;
+#endif
+}
+
+void stop_trace() {
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    trace_active = false;
+    if (trace_file.is_open()) trace_file.close();
+}
+
+std::vector<trace_record> read_trace(const std::string &path) {
+    std::ifstream is(path, std::ios::binary);
+    if (!is) throw std::runtime_error("read_trace: Cannot open " + path + ".");
+    char magic[sizeof trace_magic];
+    std::uint32_t version, flags;
+    get(is, magic);
+    get(is, version);
+    get(is, flags);
+    if (std::memcmp(magic, trace_magic, sizeof magic) != 0 ||
+        version != trace_version)
+        throw std::runtime_error("read_trace: Not a bigint trace.");
+    std::vector<trace_record> r;
+    for (std::uint8_t op; is.read(reinterpret_cast<char *>(&op), 1);) {
+        if (op >= op_count)
+            throw std::runtime_error("read_trace: Unknown operation.");
+        trace_record e;
+        std::uint8_t signs;
+        e.op = trace_op(op);
+        get(is, signs);
+        get(is, e.la);
+        get(is, e.lb);
+        e.apos = signs & 1;
+        e.bpos = signs & 2;
+        if (flags & flag_values) {
+            get_limbs(is, e.a, e.la);
+            if (e.op != trace_op::lshift && e.op != trace_op::rshift)
+                get_limbs(is, e.b, e.lb);
+        }
+        r.push_back(std::move(e));
+    }
+    return r;
+}
+
+trace_scope::trace_scope(trace_op op, const bigint &a, const bigint &b) {
+    if (trace_depth++ != 0 || !trace_active) return;
+    std::uint32_t la = std::uint32_t(a.limb_count()),
+                  lb = std::uint32_t(b.limb_count());
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    if (!trace_active) return;
+    put(std::uint8_t(op));
+    put(std::uint8_t(a.pos | b.pos << 1));
+    put(la);
+    put(lb);
+    if (trace_values) {
+        trace_file.write(reinterpret_cast<const char *>(a.num.data()),
+                         la * sizeof(unsigned));
+        trace_file.write(reinterpret_cast<const char *>(b.num.data()),
+                         lb * sizeof(unsigned));
+    }
+}
+
+trace_scope::trace_scope(trace_op op, const bigint &a, unsigned long k) {
+    if (trace_depth++ != 0 || !trace_active) return;
+    std::uint32_t la = std::uint32_t(a.limb_count()),
+                  lb = std::uint32_t(k < UINT32_MAX ? k : UINT32_MAX);
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    if (!trace_active) return;
+    put(std::uint8_t(op));
+    put(std::uint8_t(a.pos | 2));
+    put(la);
+    put(lb);
+    if (trace_values)
+        trace_file.write(reinterpret_cast<const char *>(a.num.data()),
+                         la * sizeof(unsigned));
+}
+
+trace_scope::~trace_scope() { --trace_depth; }
+}  // namespace extypes
@@ -0,0 +1,92 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace extypes {
+struct bigint;
+
+// Operation kinds in a trace. divmod covers /, % and divmod(); shifts
+// record the shift count in place of the second operand.
+enum class trace_op : std::uint8_t {
+    add,
+    sub,
+    mul,
+    divmod,
+    lshift,
+    rshift,
+    bit_and,
+    bit_or,
+    bit_xor,
+};
+const char *to_string(trace_op);
+
+// Starts appending operations to a new trace file at path, with the operand
+// limbs when `values` is set. Only a library built with BIGINT_TRACE records
+// anything; otherwise this throws std::runtime_error.
+void start_trace(const std::string &path, bool values = false);
+// Flushes and closes the trace file.
+void stop_trace();
+
+struct trace_record {
+    trace_op op;
+    bool apos, bpos;
+    // Limb counts of the operands; lb is the bit count for shifts.
+    std::uint32_t la, lb;
+    // Limbs, least significant first, if the trace has values.
+    std::vector<unsigned> a, b;
+};
+std::vector<trace_record> read_trace(const std::string &path);
+
+// Records the operation it is constructed for, unless it is nested in
+// another traced operation on the same thread, so operators implemented
+// in terms of other operators show up once.
+struct trace_scope {
+    trace_scope(trace_op, const bigint &, const bigint &);
+    trace_scope(trace_op, const bigint &, unsigned long);
+    ~trace_scope();
+    trace_scope(const trace_scope &) = delete;
+    trace_scope &operator=(const trace_scope &) = delete;
+};
+
+inline trace_op trace_kind(std::bit_and<unsigned>) {
+    return trace_op::bit_and;
+}
+inline trace_op trace_kind(std::bit_or<unsigned>) {
+    return trace_op::bit_or;
+}
+inline trace_op trace_kind(std::bit_xor<unsigned>) {
+    return trace_op::bit_xor;
+}
+}  // namespace extypes
+
+#ifdef BIGINT_TRACE
+#define BIGINT_TRACE_OP(op, a, b) \
+    ::extypes::trace_scope bigint_trace_scope_((op), (a), (b))
+#else
+#define BIGINT_TRACE_OP(op, a, b) ((void)0)
+#endif
@@ -0,0 +1,81 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include "bigdecimal.hh"
+
+using namespace extypes;
+
+TEST(bigdecimal_string, parse_print) {
+    EXPECT_EQ("123.4500", bigdecimal("123.4500").to_string());
+    EXPECT_EQ(4, bigdecimal("123.4500").scale());
+    EXPECT_EQ("-0.001", bigdecimal("-0.001").to_string());
+    EXPECT_EQ("0.00", bigdecimal("-0.00").to_string());
+    EXPECT_EQ("1234567890123456789.123456789012345678",
+              bigdecimal("1234567890123456789.123456789012345678").to_string());
+    EXPECT_EQ("1200", bigdecimal(bigint(12), -2).to_string());
+    EXPECT_ANY_THROW(bigdecimal("1.2.3"));
+    EXPECT_ANY_THROW(bigdecimal("-"));
+}
+TEST(bigdecimal_arithmetic, normal) {
+    bigdecimal a("1.25"), b("-0.125");
+    EXPECT_EQ("1.125", (a + b).to_string());
+    EXPECT_EQ("1.375", (a - b).to_string());
+    EXPECT_EQ("-0.15625", (a * b).to_string());
+    EXPECT_EQ(bigdecimal("1.1250"), a + b);
+    EXPECT_TRUE(b < a);
+}
+TEST(bigdecimal_rescale, rounding) {
+    bigdecimal a("2.5"), b("-2.5"), c("2.51");
+    EXPECT_EQ("2", a.rescale(0, rounding::half_even).to_string());
+    EXPECT_EQ("3", a.rescale(0, rounding::half_up).to_string());
+    EXPECT_EQ("2", a.rescale(0, rounding::half_down).to_string());
+    EXPECT_EQ("3", c.rescale(0, rounding::half_down).to_string());
+    EXPECT_EQ("-2", b.rescale(0, rounding::half_even).to_string());
+    EXPECT_EQ("-3", b.rescale(0, rounding::floor).to_string());
+    EXPECT_EQ("-2", b.rescale(0, rounding::ceiling).to_string());
+    EXPECT_EQ("-3", b.rescale(0, rounding::up).to_string());
+    EXPECT_EQ("-2", b.rescale(0, rounding::down).to_string());
+    EXPECT_EQ("-1", bigdecimal("-0.0000000001").rescale(0, rounding::floor)
+                        .to_string());
+    EXPECT_EQ("0", bigdecimal("0.4999999999999999999").rescale(0).to_string());
+    EXPECT_EQ("1", bigdecimal("0.5000000000000000001").rescale(0).to_string());
+    EXPECT_EQ("1000000000.000000000",
+              bigdecimal("999999999.9999999999").rescale(9).to_string());
+    EXPECT_EQ("12.300000000000",
+              bigdecimal("12.3").rescale(12).to_string());
+}
+TEST(bigdecimal_division, rounding) {
+    EXPECT_EQ("0.33", div(bigdecimal(1), bigdecimal(3), 2).to_string());
+    EXPECT_EQ("0.67", div(bigdecimal(2), bigdecimal(3), 2).to_string());
+    EXPECT_EQ("-0.67", div(bigdecimal(-2), bigdecimal(3), 2).to_string());
+    EXPECT_EQ("-0.66", div(bigdecimal(-2), bigdecimal(3), 2, rounding::down)
+                           .to_string());
+    EXPECT_EQ("0.12", div(bigdecimal("0.25"), bigdecimal(2), 2).to_string());
+    EXPECT_EQ("0.13", div(bigdecimal("0.25"), bigdecimal(2), 2,
+                          rounding::half_up)
+                          .to_string());
+    EXPECT_EQ("400",
+              div(bigdecimal("1.2"), bigdecimal("0.003"), 0).to_string());
+    EXPECT_ANY_THROW(div(bigdecimal(1), bigdecimal("0.0"), 2));
+}
@@ -0,0 +1,84 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <climits>
+#include <random>
+#include <thread>
+
+#include "bigint_accumulator.hh"
+
+using namespace extypes;
+
+TEST(bigint_accumulator, sum) {
+    std::mt19937_64 gen(3);
+    bigint_accumulator acc;
+    bigint expected = 0;
+    for (int i = 0; i < 2000; ++i) {
+        bigint a = bigint((long long)gen()) * (long long)gen() *
+                   (long long)(gen() % 1000);
+        if (i % 3 == 0) {
+            acc -= a;
+            expected -= a;
+        } else {
+            acc += a;
+            expected += a;
+        }
+        EXPECT_EQ(unsigned(i + 1), acc.pending());
+    }
+    EXPECT_EQ(expected, acc.value());
+    acc += LLONG_MIN;
+    acc -= ULONG_MAX;
+    acc += -7;
+    acc -= 5u;
+    expected = expected + LLONG_MIN - bigint(ULONG_MAX) - 7 - 5;
+    EXPECT_EQ(expected, acc.value());
+    acc -= expected;
+    EXPECT_EQ(bigint(0), acc.value());
+    EXPECT_TRUE(acc.value().sign());
+    EXPECT_ANY_THROW(acc += bigint());
+}
+TEST(bigint_accumulator, negative) {
+    bigint_accumulator acc;
+    acc -= pow(bigint(10), 27);
+    EXPECT_EQ(-pow(bigint(10), 27), acc.value());
+    acc += 1;
+    EXPECT_EQ(1 - pow(bigint(10), 27), acc.value());
+    acc.clear();
+    EXPECT_EQ(bigint(0), acc.value());
+}
+TEST(bigint_accumulator, merge) {
+    std::vector<bigint_accumulator> part(4);
+    std::vector<std::thread> ts;
+    for (int t = 0; t < 4; ++t) {
+        ts.emplace_back([&part, t] {
+            for (long i = 1; i <= 10000; ++i)
+                part.at(t) += (bigint(i) << 100) * (t % 2 ? 1 : -3);
+        });
+    }
+    for (auto &t : ts) t.join();
+    bigint_accumulator total;
+    total += 1;
+    for (const auto &p : part) total.merge(p);
+    EXPECT_EQ((bigint(50005000) << 100) * -4 + 1, total.value());
+}
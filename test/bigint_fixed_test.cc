@@ -0,0 +1,70 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include "bigint_fixed.hh"
+
+using namespace extypes;
+
+// 2^255 - 19, evaluated at compile time.
+constexpr bigint_fixed<9> p25519(
+    "5789604461865809771178549250434395392663499233282028201972879200395656481"
+    "9949");
+static_assert(p25519 > bigint_fixed<9>(0), "constexpr parse");
+static_assert(bigint_fixed<2>(999999999) * 2 == bigint_fixed<2>(1999999998LL),
+              "constexpr multiplication");
+
+TEST(bigint_fixed_arithmetic, addition) {
+    using f = bigint_fixed<2>;
+    EXPECT_EQ(f(1000000000), f(999999999) + 1);
+    EXPECT_EQ(f(-1), f(999999999) + f(-1000000000));
+    EXPECT_EQ(f(0), f(-5) + 5);
+    EXPECT_TRUE((f(0) + f(-5) + 5).sign());
+    EXPECT_THROW(f("999999999999999999") + 1, std::overflow_error);
+}
+TEST(bigint_fixed_arithmetic, subtraction) {
+    using f = bigint_fixed<2>;
+    EXPECT_EQ(f(999999999), f(1000000000) - 1);
+    EXPECT_EQ(f(-1000000000), f(-999999999) - 1);
+    EXPECT_EQ(f(3), f(-2) - f(-5));
+    EXPECT_THROW(f("-999999999999999999") - 1, std::overflow_error);
+}
+TEST(bigint_fixed_arithmetic, multiplication) {
+    using f = bigint_fixed<3>;
+    EXPECT_EQ(f("999999998000000001"), f(999999999) * f(999999999));
+    EXPECT_EQ(f(-6), f(2) * -3);
+    f r;
+    EXPECT_TRUE(f::mul_overflow(f("1000000000000000000"), f(1000000000), r));
+    EXPECT_FALSE(f::mul_overflow(f("1000000000000000000"), f(999999999), r));
+    EXPECT_EQ(f("999999999000000000000000000"), r);
+}
+TEST(bigint_fixed_conversion, bigint) {
+    bigint a("-123456789012345678901234567890");
+    bigint_fixed<4> b(a);
+    EXPECT_EQ(a, b.to_bigint());
+    EXPECT_EQ(4u, b.size());
+    EXPECT_THROW(bigint_fixed<3>{a}, std::overflow_error);
+    EXPECT_EQ("5789604461865809771178549250434395392663499233282028201972879200"
+              "3956564819949",
+              p25519.to_string());
+}
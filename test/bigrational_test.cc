@@ -0,0 +1,76 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include "bigrational.hh"
+
+using namespace extypes;
+
+TEST(bigrational_construct, normal) {
+    EXPECT_EQ("1/2", bigrational(bigint(2), bigint(4)).to_string());
+    EXPECT_EQ("-1/3", bigrational(bigint(1), bigint(-3)).to_string());
+    EXPECT_EQ("5", bigrational(bigint(-10), bigint(-2)).to_string());
+    EXPECT_EQ("0", bigrational(bigint(0), bigint(7)).to_string());
+    EXPECT_ANY_THROW(bigrational(bigint(1), bigint(0)));
+}
+TEST(bigrational_arithmetic, normal) {
+    bigrational a(bigint(1), bigint(6)), b(bigint(1), bigint(3));
+    EXPECT_EQ(bigrational(bigint(1), bigint(2)), a + b);
+    EXPECT_EQ(bigrational(bigint(-1), bigint(6)), a - b);
+    EXPECT_EQ(bigrational(bigint(1), bigint(18)), a * b);
+    EXPECT_EQ(bigrational(bigint(1), bigint(2)), a / b);
+    EXPECT_EQ(bigrational(bigint(13), bigint(6)), a + 2);
+    EXPECT_EQ(bigrational(bigint(-11), bigint(6)), a - 2);
+    EXPECT_EQ(bigrational(bigint(-11), bigint(3)),
+              bigrational(2) - b - b - b - b - b - 4);
+    EXPECT_EQ(bigrational(-2), b / bigrational(bigint(-1), bigint(6)));
+    EXPECT_EQ(bigrational(0), a - a);
+    EXPECT_ANY_THROW(a / bigrational(0));
+}
+TEST(bigrational_normalization, deferred) {
+    bigrational a(bigint(1), bigint(6)), b(bigint(1), bigint(6));
+    a += b;
+    EXPECT_FALSE(a.is_canonical());
+    EXPECT_EQ(bigint(2), a.numerator());
+    a.canonicalize();
+    EXPECT_TRUE(a.is_canonical());
+    EXPECT_EQ(bigint(1), a.numerator());
+    EXPECT_EQ(bigint(3), a.denominator());
+
+    // Growth past the threshold reduces without an explicit call.
+    bigrational s;
+    for (int i = 0; i < 200; ++i)
+        s += bigrational(bigint(1), bigint(i % 7 + 2));
+    EXPECT_LT(s.denominator(), bigint("1000000000000000000000000000000000000"));
+    EXPECT_EQ("2963/60", s.to_string());
+}
+TEST(bigrational_compare, normal) {
+    bigrational a(bigint(2), bigint(6)), b(bigint(1), bigint(3));
+    EXPECT_TRUE(a == b);
+    EXPECT_FALSE(a.is_canonical());
+    EXPECT_TRUE(bigrational(bigint(-1), bigint(2)) < bigrational(0));
+    EXPECT_TRUE(bigrational(bigint(2), bigint(3)) > b);
+    EXPECT_TRUE(bigrational(bigint(-2), bigint(3)) < -b);
+    EXPECT_TRUE(a <= b && a >= b);
+    EXPECT_TRUE(a != bigrational(bigint(3), bigint(6)));
+}
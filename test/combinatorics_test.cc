@@ -0,0 +1,75 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include "combinatorics.hh"
+
+using namespace extypes;
+
+namespace {
+bigint naive_factorial(unsigned long n) {
+    bigint r = 1;
+    for (unsigned long i = 2; i <= n; ++i) r *= i;
+    return r;
+}
+}  // namespace
+
+TEST(combinatorics, factorial) {
+    for (int n = 0; n < 300; n += 7)
+        EXPECT_EQ(naive_factorial(n), factorial(n)) << n;
+    EXPECT_EQ(naive_factorial(3001), factorial(3001));
+    EXPECT_EQ(bigint(1), factorial(0));
+    EXPECT_EQ(bigint(1), bigint(-3).fact());
+    EXPECT_THROW(factorial(-1), std::invalid_argument);
+}
+TEST(combinatorics, binomial) {
+    EXPECT_EQ(bigint(1), binomial(0, 0));
+    EXPECT_EQ(bigint(0), binomial(3, 4));
+    EXPECT_EQ(bigint(10), binomial(5, 2));
+    EXPECT_EQ(bigint("100891344545564193334812497256"), binomial(100, 50));
+    // Pascal's rule across a row.
+    for (unsigned long k = 1; k < 400; k += 13)
+        EXPECT_EQ(binomial(400, k), binomial(399, k - 1) + binomial(399, k))
+            << k;
+    unsigned long n = 2000, k = 777;
+    bigint d = naive_factorial(k) * naive_factorial(n - k);
+    EXPECT_EQ(naive_factorial(n) / d, binomial(n, k, 3));
+}
+TEST(combinatorics, multinomial) {
+    EXPECT_EQ(bigint(1), multinomial({}));
+    EXPECT_EQ(bigint(1), multinomial({0, 9}));
+    EXPECT_EQ(bigint(34650), multinomial({1, 4, 4, 2}));
+    std::vector<unsigned long> ks{100, 250, 3, 71, 500};
+    bigint d = 1;
+    unsigned long n = 0;
+    for (auto k : ks) {
+        d *= naive_factorial(k);
+        n += k;
+    }
+    EXPECT_EQ(naive_factorial(n) / d, multinomial(ks, 2));
+    EXPECT_EQ(binomial(924, 424), multinomial({500, 424}));
+    EXPECT_THROW(multinomial({~0ul, 1}), std::overflow_error);
+}
@@ -0,0 +1,108 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include "decimal_io.hh"
+
+using namespace extypes;
+
+namespace {
+std::string temp_path(const char *name) {
+    return testing::TempDir() + name;
+}
+void write_file(const std::string &path, const std::string &s) {
+    std::ofstream(path, std::ios::binary) << s;
+}
+std::string read_file(const std::string &path) {
+    std::ifstream is(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(is),
+                       std::istreambuf_iterator<char>());
+}
+std::string random_digits(std::size_t n, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::string s(n, '0');
+    for (auto &c : s) c = char('0' + gen() % 10);
+    s[0] = '7';
+    return s;
+}
+}  // namespace
+
+TEST(decimal_io, read) {
+    auto p = temp_path("decimal_io_read.txt");
+    write_file(p, "  \n-000123456789012345678901234567890\r\n");
+    EXPECT_EQ(bigint("-123456789012345678901234567890"), read_decimal(p));
+    write_file(p, "+42");
+    EXPECT_EQ(bigint(42), read_decimal(p));
+    write_file(p, "-0000000000000\n");
+    EXPECT_EQ("0", read_decimal(p).to_string());
+    for (auto bad : {"", " \n", "-", "12 34", "12a", "--1"}) {
+        write_file(p, bad);
+        EXPECT_THROW(read_decimal(p), std::invalid_argument) << bad;
+    }
+    EXPECT_ANY_THROW(read_decimal(temp_path("decimal_io_missing.txt")));
+    std::remove(p.c_str());
+}
+TEST(decimal_io, write) {
+    auto p = temp_path("decimal_io_write.txt");
+    write_decimal(p, bigint("-1000000000000000000000000001"));
+    EXPECT_EQ("-1000000000000000000000000001\n", read_file(p));
+    write_decimal(p, bigint(0));
+    EXPECT_EQ("0\n", read_file(p));
+    EXPECT_ANY_THROW(write_decimal(p, bigint()));
+    std::remove(p.c_str());
+}
+TEST(decimal_io, round_trip) {
+    auto p = temp_path("decimal_io_round_trip.txt");
+    // Spans several parse blocks and output chunks.
+    for (std::size_t n : {1u, 9u, 10u, 1000u, 1300001u}) {
+        auto s = random_digits(n, unsigned(n));
+        bigint a(s);
+        EXPECT_EQ(s, a.to_string());
+        write_decimal(p, a, 4);
+        EXPECT_EQ(s + "\n", read_file(p));
+        EXPECT_EQ(a, read_decimal(p, 4));
+        EXPECT_EQ(a, read_decimal(p, 1));
+    }
+    std::remove(p.c_str());
+}
+TEST(decimal_io, stream) {
+    auto s = random_digits(50000, 5);
+    std::ostringstream os;
+    os << bigint("-" + s) << ' ' << bigint("000000000000000000001");
+    EXPECT_EQ("-" + s + " 1", os.str());
+    std::ostringstream padded;
+    padded.width(6);
+    padded << bigint(-42);
+    EXPECT_EQ("   -42", padded.str());
+    std::istringstream is(s + " -17");
+    bigint a, b;
+    is >> a >> b;
+    EXPECT_EQ(s, a.to_string());
+    EXPECT_EQ(bigint(-17), b);
+}
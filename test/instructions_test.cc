@@ -22,6 +22,8 @@
 
 #include <gtest/gtest.h>
 
+#include <unordered_map>
+
 #include "bigint.hh"
 
 using namespace extypes;
@@ -235,3 +237,258 @@ TEST(method_fact, normal) {
                      "23758251185210916864000000000000000000000000"),
               b.fact());
 }
+
+TEST(operator_shift, left) {
+    EXPECT_EQ(bigint(8), bigint(1) << 3);
+    EXPECT_EQ(bigint(4294967296), bigint(1) << 32);
+    EXPECT_EQ(bigint(-6000000000), bigint(-3000000000) << 1);
+    EXPECT_EQ(bigint("1267650600228229401496703205376"), bigint(1) << 100);
+    EXPECT_EQ(bigint(0), bigint(0) << 200);
+    EXPECT_ANY_THROW(bigint(1) << -1);
+}
+TEST(operator_shift, right) {
+    EXPECT_EQ(bigint(1), bigint(8) >> 3);
+    EXPECT_EQ(bigint(1), bigint("1267650600228229401496703205376") >> 100);
+    EXPECT_EQ(bigint(0), bigint(4294967295) >> 32);
+    EXPECT_EQ(bigint(-1), bigint(-1) >> 1);
+    EXPECT_EQ(bigint(-2), bigint(-3) >> 1);
+    EXPECT_EQ(bigint(-1), bigint(-4294967296) >> 40);
+}
+TEST(operator_bitwise, and_or_xor) {
+    EXPECT_EQ(bigint(8), bigint(12) & bigint(10));
+    EXPECT_EQ(bigint(14), bigint(12) | bigint(10));
+    EXPECT_EQ(bigint(6), bigint(12) ^ bigint(10));
+    EXPECT_EQ(bigint(4), bigint(-12) & 14);
+    EXPECT_EQ(bigint(-2), bigint(-12) | 10);
+    EXPECT_EQ(bigint(-14), bigint(-12) ^ bigint(6));
+    EXPECT_EQ(bigint(-12), bigint(-12) & bigint(-4));
+    bigint a("340282366920938463463374607431768211455");
+    EXPECT_EQ(bigint(4294967295), a & 4294967295);
+    EXPECT_EQ(bigint(0), a ^ a);
+}
+TEST(operator_bitwise, not) {
+    EXPECT_EQ(bigint(-1), ~bigint(0));
+    EXPECT_EQ(bigint(0), ~bigint(-1));
+    EXPECT_EQ(bigint(-1000000001), ~bigint(1000000000));
+}
+TEST(method_bit_length, normal) {
+    EXPECT_EQ(0u, bigint(0).bit_length());
+    EXPECT_EQ(1u, bigint(1).bit_length());
+    EXPECT_EQ(33u, bigint(4294967296).bit_length());
+    EXPECT_EQ(101u, (bigint(-1) << 100).bit_length());
+}
+TEST(method_popcount, normal) {
+    EXPECT_EQ(0u, bigint(0).popcount());
+    EXPECT_EQ(32u, bigint(4294967295).popcount());
+    EXPECT_EQ(2u, ((bigint(1) << 100) + 1).popcount());
+}
+TEST(method_test_bit, normal) {
+    EXPECT_TRUE(bigint(5).test_bit(0));
+    EXPECT_FALSE(bigint(5).test_bit(1));
+    EXPECT_TRUE((bigint(1) << 100).test_bit(100));
+    EXPECT_FALSE((bigint(1) << 100).test_bit(99));
+    EXPECT_FALSE(bigint(-2).test_bit(0));
+    EXPECT_TRUE(bigint(-2).test_bit(1000));
+}
+
+TEST(method_compare, normal) {
+    EXPECT_EQ(0, bigint(0).compare(-bigint(0)));
+    EXPECT_EQ(-1, bigint(-5).compare(bigint(3)));
+    EXPECT_EQ(1, bigint(1000000000).compare(bigint(999999999)));
+    EXPECT_EQ(-1, bigint(-1000000000).compare(bigint(-999999999)));
+    EXPECT_EQ(0, bigint(std::vector<unsigned>{7, 0, 0}).compare(bigint(7)));
+    EXPECT_EQ(1, bigint(LLONG_MAX).compare(LLONG_MIN));
+    EXPECT_EQ(0, bigint(LLONG_MIN).compare(LLONG_MIN));
+    EXPECT_EQ(-1, bigint(-1).compare(0u));
+    EXPECT_EQ(1, bigint("18446744073709551616").compare(ULONG_MAX));
+}
+TEST(operator_comparison, scalar) {
+    EXPECT_TRUE(bigint(-0) == 0);
+    EXPECT_TRUE(bigint(3) != 4L);
+    EXPECT_TRUE(bigint(3) < 4LL);
+    EXPECT_TRUE(bigint(3) <= 3u);
+    EXPECT_TRUE(5 > bigint(3));
+    EXPECT_TRUE(3UL >= bigint(3));
+}
+TEST(method_hash, normal) {
+    std::hash<bigint> h;
+    EXPECT_EQ(h(bigint(0)), h(-bigint(0)));
+    EXPECT_EQ(h(bigint(7)), h(bigint(std::vector<unsigned>{7, 0})));
+    EXPECT_NE(h(bigint(7)), h(bigint(-7)));
+    std::unordered_map<bigint, int> m;
+    m[bigint("123456789012345678901234567890")] = 1;
+    m[bigint(0)] = 2;
+    EXPECT_EQ(1, m[bigint("123456789012345678901234567890")]);
+    EXPECT_EQ(2, m[-bigint(0)]);
+    EXPECT_EQ(2u, m.size());
+}
+
+TEST(function_three_operand, aliasing) {
+    bigint a("123456789012345678901234567890"), b(-987654321);
+    bigint r;
+    mul(r, a, b);
+    EXPECT_EQ(a * b, r);
+    mul(a, a, a);
+    EXPECT_EQ(bigint("152415787532388367504953515625361987875019051998750190521"
+                     "00"),
+              a);
+    add(b, b, b);
+    EXPECT_EQ(bigint(-1975308642), b);
+    sub(b, b, b);
+    EXPECT_EQ(bigint(0), b);
+    EXPECT_TRUE(b.sign());
+    bigint q, m(7);
+    divmod(q, m, bigint(-100), m);
+    EXPECT_EQ(bigint(-14), q);
+    EXPECT_EQ(bigint(-2), m);
+    EXPECT_ANY_THROW(divmod(q, q, bigint(1), bigint(1)));
+    EXPECT_ANY_THROW(divmod(q, m, bigint(1), bigint(0)));
+}
+TEST(function_three_operand, addmul_submul) {
+    bigint r(10);
+    addmul(r, bigint(3), bigint(4));
+    EXPECT_EQ(bigint(22), r);
+    submul(r, bigint(5), bigint(5));
+    EXPECT_EQ(bigint(-3), r);
+}
+TEST(function_three_operand, capacity) {
+    bigint a("123456789012345678901234567890123456789"), r;
+    r.reserve(16);
+    auto c = r.capacity();
+    EXPECT_LE(16u, c);
+    for (int i = 0; i < 10; ++i) {
+        mul(r, a, a);
+        add(r, r, a);
+    }
+    EXPECT_EQ(c, r.capacity());
+    r = 1;
+    r.shrink_to_fit();
+    EXPECT_GT(c, r.capacity());
+}
+TEST(operator_compound_division, long_divisor) {
+    bigint a("123456789012345678901234567890123456789012345678901234567890");
+    bigint b("98765432109876543210987654321");
+    EXPECT_EQ(bigint("1249999988609375000142382812499"), a / b);
+    EXPECT_EQ(bigint("1249999988609375000142382812499") * b + a % b, a);
+    bigint c(999999999999);
+    EXPECT_EQ(bigint(999), c /= 1000000000LL);
+}
+TEST(operator_multiplication, karatsuba) {
+    // (10^n - 1)^2 = 10^2n - 2 * 10^n + 1, well past the Karatsuba
+    // threshold and with unbalanced operands.
+    bigint a(std::string(2000, '9')), b(std::string(700, '9'));
+    bigint p = pow(bigint(10), 2000);
+    EXPECT_EQ(p * p - 2 * p + 1, a * a);
+    EXPECT_EQ(a * (pow(bigint(10), 700) - 1), a * b);
+    EXPECT_EQ(b * a, a * b);
+    EXPECT_EQ(a, a * a / a);
+}
+TEST(operator_multiplication, square) {
+    // Squares take their own path; compare with products of equal copies.
+    for (std::size_t n : {1u, 17u, 39u, 40u, 81u, 333u}) {
+        bigint a(std::vector<unsigned>(n, 999999999)), b = a;
+        bigint s = a;
+        s *= s;
+        EXPECT_EQ(a * b, a * a) << n;
+        EXPECT_EQ(a * b, s) << n;
+        EXPECT_EQ(a * b, pow(a, 2)) << n;
+    }
+}
+TEST(function_import_export, formats) {
+    const unsigned char be[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    bigint a, b;
+    import_words(a, 10, 1, 1, 1, be);
+    EXPECT_EQ(bigint("4759477275222530853130"), a);
+    // The same bytes as five little-endian 16-bit words, least significant
+    // first.
+    const unsigned char le[] = {10, 9, 8, 7, 6, 5, 4, 3, 2, 1};
+    import_words(b, 5, -1, 2, -1, le);
+    EXPECT_EQ(a, b);
+    unsigned char out[16] = {};
+    EXPECT_EQ(4u, export_count(a, 3));
+    EXPECT_EQ(4u, export_words(out, 1, 3, 1, -a));
+    const unsigned char expected[] = {0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    for (int i = 0; i < 12; ++i) EXPECT_EQ(expected[i], out[i]);
+    EXPECT_EQ(0u, export_words(out, 1, 8, 0, bigint(0)));
+    bigint c = pow(bigint(3), 1000);
+    std::vector<unsigned long long> w(export_count(c, 8));
+    EXPECT_EQ(w.size(), export_words(w.data(), -1, 8, 0, c));
+    import_words(b, w.size(), -1, 8, 0, w.data());
+    EXPECT_EQ(c, b);
+    EXPECT_ANY_THROW(import_words(b, 1, 0, 1, 1, be));
+    EXPECT_ANY_THROW(export_words(out, 1, 0, 1, a));
+}
+TEST(method_limbs, view_and_move) {
+    bigint a("-1000000000000000002");
+    auto l = a.limbs();
+    ASSERT_EQ(3u, l.size());
+    EXPECT_EQ(2u, l[0]);
+    EXPECT_EQ(1u, l[2]);
+    EXPECT_TRUE(bigint().limbs().empty());
+    std::vector<unsigned> v = {5, 0, 7};
+    const unsigned *p = v.data();
+    bigint b(std::move(v), false);
+    EXPECT_EQ(p, b.limbs().data());
+    EXPECT_EQ(bigint("-7000000000000000005"), b);
+    bigint c(std::move(b));
+    EXPECT_EQ(p, c.limbs().data());
+    a = std::move(c);
+    EXPECT_EQ(p, a.limbs().data());
+}
+TEST(method_fits_in, normal) {
+    EXPECT_TRUE(bigint(INT_MAX).fits_in<int>());
+    EXPECT_TRUE(bigint(INT_MIN).fits_in<int>());
+    EXPECT_FALSE((bigint(INT_MAX) + 1).fits_in<int>());
+    EXPECT_FALSE((bigint(INT_MIN) - 1).fits_in<int>());
+    EXPECT_FALSE(bigint(-1).fits_in<unsigned>());
+    EXPECT_TRUE(bigint(LLONG_MIN).fits_in<long long>());
+    EXPECT_TRUE(bigint(ULONG_MAX).fits_in<unsigned long>());
+    EXPECT_FALSE(pow(bigint(10), 40).fits_in<long long>());
+    EXPECT_FALSE(bigint().fits_in<int>());
+    EXPECT_EQ(-5, *bigint(-5).try_convert<short>());
+    EXPECT_FALSE(bigint(70000).try_convert<short>());
+    EXPECT_EQ(LLONG_MIN, *bigint(LLONG_MIN).try_convert<long long>());
+    EXPECT_THROW((void)int(bigint(INT_MAX) + 1), std::out_of_range);
+}
+#ifdef __SIZEOF_INT128__
+TEST(constructor_int128, normal) {
+    int128 m = -(int128(1) << 126) * 2;
+    EXPECT_EQ(bigint("-170141183460469231731687303715884105728"), bigint(m));
+    EXPECT_EQ(m, int128(bigint(m)));
+    uint128 u = ~uint128(0);
+    EXPECT_EQ(bigint("340282366920938463463374607431768211455"), bigint(u));
+    EXPECT_EQ(u, uint128(bigint(u)));
+    EXPECT_FALSE((bigint(u) + 1).fits_in<uint128>());
+    EXPECT_THROW((void)int128(bigint(u)), std::out_of_range);
+}
+#endif
+TEST(method_to_double, rounding) {
+    EXPECT_EQ(0.0, bigint(0).to_double());
+    EXPECT_EQ(-12345.0, bigint(-12345).to_double());
+    // 2^53 + 1 is a tie and rounds to even, 2^53 + 3 rounds up.
+    bigint p = bigint(1) << 53;
+    EXPECT_EQ(9007199254740992.0, (p + 1).to_double());
+    EXPECT_EQ(9007199254740996.0, (p + 3).to_double());
+    // Above the tie only because of a bit far below the top 64.
+    EXPECT_EQ(9007199254740994.0, (((p + 1) << 100) + 1).to_double() / 0x1p100);
+    EXPECT_EQ(HUGE_VAL, pow(bigint(10), 400).to_double());
+    EXPECT_EQ(-HUGE_VAL, (-(bigint(1) << 1024)).to_double());
+    EXPECT_TRUE(std::isnan(bigint().to_double()));
+}
+TEST(method_frexp, normal) {
+    long e;
+    EXPECT_EQ(0.5, (bigint(1) << 5000).frexp(e));
+    EXPECT_EQ(5001, e);
+    EXPECT_EQ(-0.75, bigint(-6).frexp(e));
+    EXPECT_EQ(3, e);
+    EXPECT_EQ(0.0, bigint(0).frexp(e));
+    EXPECT_EQ(0, e);
+}
+TEST(function_from_double, normal) {
+    EXPECT_EQ(bigint(-3), bigint::from_double(-3.99));
+    EXPECT_EQ(bigint(1) << 100, bigint::from_double(0x1p100));
+    EXPECT_EQ(-(bigint(3) << 70), bigint::from_double(-0x3p70));
+    EXPECT_EQ(bigint(0), bigint::from_double(-0.5));
+    EXPECT_ANY_THROW(bigint::from_double(HUGE_VAL));
+    EXPECT_ANY_THROW(bigint::from_double(std::nan("")));
+}
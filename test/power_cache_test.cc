@@ -0,0 +1,130 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "power_cache.hh"
+
+using namespace extypes;
+
+TEST(power_cache, warm_clear) {
+    clear_power_cache();
+    EXPECT_EQ(0u, power_cache_size());
+    warm_power_cache(4096);
+    auto size = power_cache_size();
+    EXPECT_LT(0u, size);
+    EXPECT_EQ(pow(bigint(2), 5000), bigint(1) << 5000);
+    EXPECT_LE(size, power_cache_size());
+    clear_power_cache();
+    EXPECT_EQ(0u, power_cache_size());
+}
+TEST(power_cache, limit) {
+    clear_power_cache();
+    set_power_cache_limit(0);
+    EXPECT_EQ(pow(bigint(2), 3000), bigint(1) << 3000);
+    EXPECT_EQ(-pow(bigint(2), 3000), (bigint(-1) << 3000) ^ 0);
+    EXPECT_EQ(0u, power_cache_size());
+    set_power_cache_limit(std::size_t(16) << 20);
+}
+TEST(power_cache, concurrent) {
+    clear_power_cache();
+    bigint expected = pow(bigint(2), 20000) - 1;
+    std::vector<std::thread> ts;
+    std::vector<int> ok(4, 0);
+    for (int t = 0; t < 4; ++t) {
+        ts.emplace_back([&, t] {
+            for (int i = 0; i < 20; ++i)
+                ok.at(t) += ((bigint(1) << 20000) - 1 == expected) &&
+                            ((expected ^ 0) == expected);
+        });
+    }
+    for (int i = 0; i < 20; ++i) clear_power_cache();
+    for (auto &t : ts) t.join();
+    for (int t = 0; t < 4; ++t) EXPECT_EQ(20, ok.at(t));
+}
+TEST(power_cache, clear_while_reading) {
+    // Readers convert while another thread keeps clearing the cache, so
+    // entries are freed and republished under them.
+    std::vector<unsigned> w(600);
+    for (std::size_t i = 0; i < w.size(); ++i) w[i] = unsigned(i * 2654435761u);
+    bigint expected;
+    import_words(expected, w.size(), -1, 4, 0, w.data());
+    bigint shifted = expected << 12345;
+    std::atomic<bool> done(false);
+    std::thread clearer([&] {
+        while (!done) clear_power_cache();
+    });
+    std::vector<std::thread> ts;
+    std::vector<int> ok(4, 0);
+    for (int t = 0; t < 4; ++t) {
+        ts.emplace_back([&, t] {
+            for (int i = 0; i < 100; ++i) {
+                bigint a;
+                import_words(a, w.size(), -1, 4, 0, w.data());
+                ok.at(t) += a == expected && (a << 12345) == shifted;
+            }
+        });
+    }
+    for (auto &t : ts) t.join();
+    done = true;
+    clearer.join();
+    for (int t = 0; t < 4; ++t) EXPECT_EQ(100, ok.at(t));
+}
+TEST(power_cache, concurrent_clears) {
+    // Several clears overlap with readers and fillers; none may free an
+    // entry that a reader still holds.
+    std::vector<unsigned> w(600);
+    for (std::size_t i = 0; i < w.size(); ++i) w[i] = unsigned(i * 40503u);
+    bigint expected;
+    import_words(expected, w.size(), -1, 4, 0, w.data());
+    std::atomic<bool> done(false);
+    std::vector<std::thread> others;
+    for (int t = 0; t < 3; ++t) {
+        others.emplace_back([&] {
+            while (!done) clear_power_cache();
+        });
+    }
+    for (int t = 0; t < 2; ++t) {
+        others.emplace_back([&] {
+            while (!done) warm_power_cache(1 << 16);
+        });
+    }
+    std::vector<std::thread> ts;
+    std::vector<int> ok(4, 0);
+    for (int t = 0; t < 4; ++t) {
+        ts.emplace_back([&, t] {
+            for (int i = 0; i < 100; ++i) {
+                bigint a;
+                import_words(a, w.size(), -1, 4, 0, w.data());
+                ok.at(t) += a == expected;
+            }
+        });
+    }
+    for (auto &t : ts) t.join();
+    done = true;
+    for (auto &t : others) t.join();
+    for (int t = 0; t < 4; ++t) EXPECT_EQ(100, ok.at(t));
+}
@@ -0,0 +1,87 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include "prime.hh"
+
+using namespace extypes;
+
+TEST(function_is_probable_prime, small) {
+    int primes = 0;
+    for (int i = -5; i < 10000; ++i) primes += is_probable_prime(i);
+    EXPECT_EQ(1229, primes);
+    EXPECT_TRUE(is_probable_prime(999983));
+    EXPECT_FALSE(is_probable_prime(999981));
+}
+TEST(function_is_probable_prime, large) {
+    // 2^127 - 1 and 2^521 - 1 are Mersenne primes.
+    EXPECT_TRUE(is_probable_prime((bigint(1) << 127) - 1));
+    EXPECT_TRUE(is_probable_prime((bigint(1) << 521) - 1));
+    EXPECT_FALSE(is_probable_prime((bigint(1) << 128) + 1));
+    // Strong pseudoprimes to base 2 and a Carmichael number.
+    EXPECT_FALSE(is_probable_prime(bigint(3215031751LL)));
+    EXPECT_FALSE(is_probable_prime(bigint(2152302898747LL)));
+    EXPECT_FALSE(is_probable_prime(bigint(3825123056546413051LL)));
+    // With a single Miller-Rabin round only the Lucas test rejects them.
+    EXPECT_FALSE(is_probable_prime(bigint(3825123056546413051LL), 1));
+    EXPECT_FALSE(is_probable_prime(bigint("318665857834031151167461"), 1));
+    // Square of a prime.
+    EXPECT_FALSE(is_probable_prime(bigint(1000003) * 1000003));
+}
+TEST(function_next_prime, normal) {
+    EXPECT_EQ(bigint(2), next_prime(-10));
+    EXPECT_EQ(bigint(3), next_prime(2));
+    EXPECT_EQ(bigint(1000003), next_prime(1000000));
+    EXPECT_EQ(bigint("1000000000000000000000007"),
+              next_prime(bigint("1000000000000000000000000")));
+}
+TEST(function_batch_primes, array) {
+    std::vector<bigint> a = {bigint(1), bigint(2), bigint(91),
+                             (bigint(1) << 127) - 1, bigint(1000003) * 1000033,
+                             bigint("1000000000000000000000007")};
+    std::vector<bool> expected = {false, true, false, true, false, true};
+    EXPECT_EQ(expected, are_probable_primes(a, 4, 3));
+}
+TEST(function_batch_primes, range) {
+    EXPECT_EQ(25u, probable_primes_in_range(0, 100).size());
+    EXPECT_EQ(1229u, probable_primes_in_range(1, 10000, 4, 2).size());
+    auto r = probable_primes_in_range(bigint("1000000000000000000000000"),
+                                      bigint("1000000000000000000000100"), 4,
+                                      4);
+    ASSERT_EQ(2u, r.size());
+    EXPECT_EQ(bigint("1000000000000000000000007"), r.at(0));
+    EXPECT_EQ(bigint("1000000000000000000000049"), r.at(1));
+}
+TEST(function_batch_primes, range_segments) {
+    // Several sieve segments, checked against single tests.
+    bigint lo("18446744073709551000"), hi = lo + 150000;
+    auto r = probable_primes_in_range(lo, hi, 4, 4);
+    std::size_t k = 0;
+    for (bigint x = lo; x <= hi; ++x) {
+        if (!is_probable_prime(x)) continue;
+        ASSERT_LT(k, r.size());
+        EXPECT_EQ(x, r.at(k++));
+    }
+    EXPECT_EQ(k, r.size());
+    EXPECT_EQ(6543u, probable_primes_in_range(0, 65537).size());
+}
@@ -0,0 +1,58 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include "product_tree.hh"
+
+using namespace extypes;
+
+TEST(product_tree, product) {
+    std::vector<bigint> a;
+    bigint p = 1;
+    for (int i = 1; i <= 300; ++i) {
+        a.push_back(bigint(i) * 1000000007);
+        p *= a.back();
+    }
+    product_tree t(a, 4);
+    EXPECT_EQ(300u, t.size());
+    EXPECT_EQ(10u, t.height());
+    EXPECT_EQ(p, t.product());
+    EXPECT_EQ(p, product(a, 1));
+    EXPECT_EQ(bigint(1), product({}));
+    EXPECT_EQ(bigint(-6), product({bigint(2), bigint(-3)}));
+}
+TEST(product_tree, remainders) {
+    std::vector<bigint> m;
+    for (int i = 0; i < 100; ++i) m.push_back(bigint(i + 2) * (i + 3) + 1);
+    m.push_back(bigint("123456789012345678901234567890"));
+    bigint x = pow(bigint(3), 2000) + 12345;
+    product_tree t(m);
+    auto r = t.remainders(x, 3);
+    ASSERT_EQ(m.size(), r.size());
+    for (std::size_t i = 0; i < m.size(); ++i) EXPECT_EQ(x % m[i], r[i]);
+    r = remainder_tree(-x, m, 1);
+    for (std::size_t i = 0; i < m.size(); ++i) EXPECT_EQ(-x % m[i], r[i]);
+    EXPECT_TRUE(product_tree().remainders(x).empty());
+    EXPECT_ANY_THROW(remainder_tree(x, {bigint(3), bigint(0)}));
+    EXPECT_ANY_THROW(product({bigint(3), bigint()}, 2));
+}
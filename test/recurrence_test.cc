@@ -0,0 +1,89 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include "recurrence.hh"
+
+using namespace extypes;
+
+namespace {
+// a_n by iterating the recurrence.
+bigint iterate(const std::vector<bigint> &c, std::vector<bigint> a,
+               unsigned long n) {
+    auto k = c.size();
+    while (a.size() <= n) {
+        bigint t = 0;
+        for (std::size_t j = 0; j < k; ++j) t += c[j] * a[a.size() - 1 - j];
+        a.push_back(t);
+    }
+    return a[n];
+}
+}  // namespace
+
+TEST(recurrence, fibonacci_lucas) {
+    bigint f0 = 0, f1 = 1, l0 = 2, l1 = 1;
+    for (unsigned long n = 0; n < 1500; ++n) {
+        EXPECT_EQ(f0, fibonacci(n)) << n;
+        EXPECT_EQ(l0, lucas(n)) << n;
+        f0 += f1;
+        std::swap(f0, f1);
+        l0 += l1;
+        std::swap(l0, l1);
+    }
+    EXPECT_EQ(bigint("354224848179261915075"), fibonacci(100));
+    EXPECT_EQ(bigint("792070839848372253127"), lucas(100));
+    // F(2n) = F(n) L(n).
+    EXPECT_EQ(fibonacci(20001) * lucas(20001), fibonacci(40002));
+}
+TEST(recurrence, modular) {
+    bigint m("1000000000000000000000007");
+    for (unsigned long n : {0ul, 1ul, 2ul, 3ul, 97ul, 1000ul, 4097ul}) {
+        EXPECT_EQ(fibonacci(n) % m, fibonacci(n, m)) << n;
+        EXPECT_EQ(lucas(n) % m, lucas(n, m)) << n;
+        EXPECT_EQ(fibonacci(n) % 10, fibonacci(n, 10)) << n;
+    }
+    // Pisano period of 10 is 60.
+    EXPECT_EQ(fibonacci(7, 10), fibonacci(60000000000007ul, 10));
+    EXPECT_EQ(bigint(0), fibonacci(12345, 1));
+    EXPECT_THROW(fibonacci(5, 0), std::invalid_argument);
+    EXPECT_THROW(lucas(5, -7), std::invalid_argument);
+}
+TEST(recurrence, linear_recurrence) {
+    std::vector<bigint> c{2, -1, bigint("12345678901234567890"), 0, 7},
+        a{1, 0, -3, 5, bigint("99999999999")};
+    for (unsigned long n : {0ul, 3ul, 4ul, 5ul, 6ul, 31ul, 64ul, 200ul})
+        EXPECT_EQ(iterate(c, a, n), linear_recurrence(c, a, n)) << n;
+    bigint m("987654321987654321");
+    for (unsigned long n : {2ul, 9ul, 150ul}) {
+        bigint e = iterate(c, a, n) % m;
+        if (!e.sign()) e += m;
+        EXPECT_EQ(e, linear_recurrence(c, a, n, m)) << n;
+    }
+    EXPECT_EQ(fibonacci(777), linear_recurrence({1, 1}, {0, 1}, 777));
+    EXPECT_EQ(pow(bigint(-3), 50), linear_recurrence({-3}, {1}, 50));
+    EXPECT_THROW(linear_recurrence({}, {}, 3), std::invalid_argument);
+    EXPECT_THROW(linear_recurrence({1, 1}, {0}, 3), std::invalid_argument);
+}
@@ -0,0 +1,160 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "shared_bigint.hh"
+
+using namespace extypes;
+
+TEST(shared_bigint, sharing) {
+    shared_bigint a(bigint("-123456789012345678901234567890"));
+    EXPECT_FALSE(a.sign());
+    EXPECT_EQ(bigint("123456789012345678901234567890"), a.magnitude());
+    shared_bigint b = a, c = -a, d = a.abs(), e = +c;
+    EXPECT_EQ(5, a.use_count());
+    EXPECT_EQ(&a.magnitude(), &d.magnitude());
+    EXPECT_EQ("-123456789012345678901234567890", b.to_string());
+    EXPECT_EQ("123456789012345678901234567890", c.to_string());
+    EXPECT_EQ(c, d);
+    EXPECT_EQ(c, e);
+    EXPECT_EQ(a, -c);
+    EXPECT_EQ("0", (-shared_bigint(0)).to_string());
+    EXPECT_TRUE((-shared_bigint(0)).sign());
+    EXPECT_EQ("NaN", shared_bigint().to_string());
+    EXPECT_ANY_THROW(shared_bigint() + 1);
+}
+TEST(shared_bigint, copy_on_write) {
+    shared_bigint a(bigint("1000000000000000000000")), b = a;
+    const bigint *storage = &a.magnitude();
+    b += -a;
+    EXPECT_EQ("1000000000000000000000", a.to_string());
+    EXPECT_EQ(shared_bigint(0), b);
+    EXPECT_EQ(1, a.use_count());
+    a *= -2;
+    EXPECT_EQ(storage, &a.magnitude());
+    EXPECT_EQ("-2000000000000000000000", a.to_string());
+    a -= a;
+    EXPECT_EQ(shared_bigint(0), a);
+
+    shared_bigint c(bigint(-7)), d = c;
+    bigint v = std::move(c).value();
+    EXPECT_EQ(bigint(-7), v);
+    EXPECT_EQ("NaN", c.to_string());
+    EXPECT_EQ(bigint(-7), d.value());
+    bigint w = std::move(d).value();
+    EXPECT_EQ(bigint(-7), w);
+}
+TEST(shared_bigint, arithmetic) {
+    std::mt19937_64 gen(5);
+    for (int i = 0; i < 500; ++i) {
+        bigint x = bigint((long long)gen()) * (long long)gen() *
+                   (long long)(gen() % 7) * (i % 2 ? 1 : -1);
+        bigint y = bigint((long long)gen()) * (long long)(gen() % 3);
+        if (i % 3 == 0) y = -y;
+        shared_bigint a(x), b(y);
+        EXPECT_EQ(x + y, (a + b).value());
+        EXPECT_EQ(x - y, (a - b).value());
+        EXPECT_EQ(-x - y, (-a - b).value());
+        EXPECT_EQ(x * y, (a * b).value());
+        EXPECT_EQ(x.compare(y), a.compare(b));
+        EXPECT_EQ(x.hash(), a.hash());
+        shared_bigint c = a;
+        c -= b;
+        EXPECT_EQ(x - y, c.value());
+        if (y == 0) {
+            EXPECT_ANY_THROW(a / b);
+            EXPECT_ANY_THROW(c /= b);
+            EXPECT_EQ(x - y, c.value());
+            continue;
+        }
+        EXPECT_EQ(x / y, (a / b).value());
+        EXPECT_EQ(x % y, (a % b).value());
+        EXPECT_EQ(-x / y, (-a / b).value());
+        EXPECT_EQ(-x % y, (-a % b).value());
+        c = a;
+        c %= -b;
+        EXPECT_EQ(x % -y, c.value());
+    }
+}
+TEST(shared_bigint, threads) {
+    shared_bigint a = pow(bigint(7), 5000);
+    std::vector<std::thread> ts;
+    std::vector<bigint> r(4);
+    for (int t = 0; t < 4; ++t)
+        ts.emplace_back([&, t] {
+            shared_bigint b = t % 2 ? -a : a;
+            for (int i = 0; i < 100; ++i) b += t;
+            r[t] = b.value();
+        });
+    for (auto &t : ts) t.join();
+    bigint v = pow(bigint(7), 5000);
+    for (int t = 0; t < 4; ++t)
+        EXPECT_EQ((t % 2 ? -v : v) + 100 * t, r[t]);
+    EXPECT_EQ(1, a.use_count());
+}
+TEST(shared_bigint, drop_while_mutating) {
+    // Readers drop their copies while the owner updates its value, which
+    // happens in place once it is the last handle.
+    shared_bigint a = pow(bigint(3), 3000);
+    for (int round = 0; round < 50; ++round) {
+        std::vector<std::thread> ts;
+        std::vector<bigint> seen(4);
+        bigint v = a.value();
+        for (int t = 0; t < 4; ++t) {
+            ts.emplace_back([&seen, t, b = a]() mutable {
+                seen[t] = b.value();
+                b = shared_bigint();
+            });
+        }
+        for (int i = 0; i < 20; ++i) a += 1;
+        for (auto &t : ts) t.join();
+        for (int t = 0; t < 4; ++t) EXPECT_EQ(v, seen[t]);
+        EXPECT_EQ(v + 20, a.value());
+        EXPECT_EQ(1, a.use_count());
+    }
+}
+TEST(shared_bigint, io) {
+    std::unordered_set<shared_bigint> s{shared_bigint(3), -shared_bigint(-3)};
+    EXPECT_EQ(1u, s.size());
+    std::ostringstream os;
+    os << -shared_bigint(bigint("1000000000000")) << ' '
+       << shared_bigint(-5).abs();
+    EXPECT_EQ("-1000000000000 5", os.str());
+}
+TEST(bigint, rvalue_sign) {
+    bigint a("-98765432109876543210");
+    auto p = a.limbs().begin();
+    bigint b = std::move(a).abs();
+    EXPECT_EQ(p, b.limbs().begin());
+    bigint c = -std::move(b);
+    EXPECT_EQ(p, c.limbs().begin());
+    EXPECT_EQ("-98765432109876543210", c.to_string());
+    EXPECT_EQ(bigint("98765432109876543210"), abs(std::move(c)));
+}
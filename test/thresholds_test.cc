@@ -0,0 +1,95 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "bigint.hh"
+
+using namespace extypes;
+
+namespace {
+std::vector<unsigned> random_limbs(std::mt19937 &gen, std::size_t n) {
+    std::uniform_int_distribution<unsigned> limb(0, 999999999);
+    std::vector<unsigned> r(n);
+    for (auto &e : r) e = limb(gen);
+    return r;
+}
+}  // namespace
+
+TEST(thresholds, set_get) {
+    auto d = default_thresholds();
+    set_thresholds({7, 9});
+    EXPECT_EQ(7u, get_thresholds().karatsuba);
+    EXPECT_EQ(9u, get_thresholds().binary_split);
+    EXPECT_THROW(set_thresholds({3, 9}), std::invalid_argument);
+    EXPECT_THROW(set_thresholds({7, 0}), std::invalid_argument);
+    EXPECT_EQ(7u, get_thresholds().karatsuba);
+    set_thresholds(d);
+}
+TEST(thresholds, files) {
+    auto d = default_thresholds();
+    auto p = testing::TempDir() + "thresholds.txt";
+    save_thresholds(p, {33, 44});
+    auto t = load_thresholds(p);
+    EXPECT_EQ(33u, t.karatsuba);
+    EXPECT_EQ(44u, get_thresholds().binary_split);
+    std::ofstream(p) << "# tuned\n\nbinary_split 12  # words\n";
+    t = load_thresholds(p);
+    EXPECT_EQ(33u, t.karatsuba);
+    EXPECT_EQ(12u, t.binary_split);
+    for (auto bad : {"karatsuba\n", "karatsuba x\n", "karatsuba 3\n",
+                     "karatsuba 8 9\n", "toom 8\n", "binary_split -1\n"}) {
+        std::ofstream(p) << bad;
+        EXPECT_THROW(load_thresholds(p), std::invalid_argument) << bad;
+    }
+    EXPECT_EQ(get_thresholds().karatsuba, 33u);
+    EXPECT_THROW(load_thresholds(p + ".missing"), std::runtime_error);
+    std::remove(p.c_str());
+    set_thresholds(d);
+}
+TEST(thresholds, results_do_not_depend_on_thresholds) {
+    auto d = default_thresholds();
+    std::mt19937 gen(9);
+    for (std::size_t n : {1u, 5u, 37u, 130u}) {
+        bigint a(random_limbs(gen, n)), b(random_limbs(gen, n + 3));
+        std::vector<unsigned> w(4 * n + 1);
+        for (auto &e : w) e = unsigned(gen());
+        set_thresholds({1000000, 1000000});
+        bigint p = a * b, x;
+        import_words(x, w.size(), -1, 4, 0, w.data());
+        for (thresholds t : {thresholds{4, 1}, thresholds{5, 2}, d}) {
+            set_thresholds(t);
+            EXPECT_EQ(p, a * b) << n;
+            bigint y;
+            import_words(y, w.size(), -1, 4, 0, w.data());
+            EXPECT_EQ(x, y) << n;
+        }
+    }
+    set_thresholds(d);
+}
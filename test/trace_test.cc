@@ -0,0 +1,65 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include "bigint.hh"
+
+using namespace extypes;
+
+TEST(trace, record_read) {
+    auto path = testing::TempDir() + "bigint_trace_test.bin";
+    bigint a("-1234567890123456789"), b(1000), r;
+    start_trace(path, true);
+    r = a + b;
+    r = a * b;
+    r = a / b;
+    r = a << 100;
+    r = a & b;
+    stop_trace();
+    r = a - b;
+    auto t = read_trace(path);
+    ASSERT_EQ(5u, t.size());
+    EXPECT_EQ(trace_op::add, t[0].op);
+    EXPECT_EQ(trace_op::mul, t[1].op);
+    EXPECT_EQ(trace_op::divmod, t[2].op);
+    EXPECT_EQ(trace_op::lshift, t[3].op);
+    EXPECT_EQ(trace_op::bit_and, t[4].op);
+    EXPECT_EQ(3u, t[0].la);
+    EXPECT_EQ(1u, t[0].lb);
+    EXPECT_FALSE(t[0].apos);
+    EXPECT_TRUE(t[0].bpos);
+    EXPECT_EQ(a, bigint(t[1].a, t[1].apos));
+    EXPECT_EQ(b, bigint(t[1].b, t[1].bpos));
+    EXPECT_EQ(100u, t[3].lb);
+    EXPECT_TRUE(t[3].b.empty());
+
+    start_trace(path);
+    r = a - b;
+    stop_trace();
+    t = read_trace(path);
+    ASSERT_EQ(1u, t.size());
+    EXPECT_EQ(trace_op::sub, t[0].op);
+    EXPECT_TRUE(t[0].a.empty());
+    EXPECT_STREQ("sub", to_string(t[0].op));
+    EXPECT_ANY_THROW(read_trace(testing::TempDir() + "no_such_trace.bin"));
+}
@@ -0,0 +1,118 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Replays a trace recorded by a BIGINT_TRACE build and prints latency
+// percentiles per operation kind.
+//
+//   bigint_replay <trace> [repeat]
+//
+// Operands come from the trace when it was recorded with values, and are
+// otherwise random numbers with the recorded limb counts and signs. Each
+// operation runs `repeat` times (default 1) and the mean time is taken.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <random>
+#include <vector>
+
+#include "bigint.hh"
+
+using namespace extypes;
+
+namespace {
+std::vector<unsigned> random_limbs(std::mt19937 &gen, std::uint32_t n) {
+    std::uniform_int_distribution<unsigned> limb(0, 999999999),
+        top(1, 999999999);
+    std::vector<unsigned> r(std::max<std::uint32_t>(n, 1));
+    for (auto &e : r) e = limb(gen);
+    if (n != 0) r.back() = top(gen);
+    else
+        r.back() = 0;
+    return r;
+}
+
+void run(const trace_record &e, bigint &r, bigint &s, const bigint &a,
+         const bigint &b) {
+    switch (e.op) {
+    case trace_op::add: add(r, a, b); break;
+    case trace_op::sub: sub(r, a, b); break;
+    case trace_op::mul: mul(r, a, b); break;
+    case trace_op::divmod: divmod(r, s, a, b); break;
+    case trace_op::lshift: r = a << (unsigned long)e.lb; break;
+    case trace_op::rshift: r = a >> (unsigned long)e.lb; break;
+    case trace_op::bit_and: r = a & b; break;
+    case trace_op::bit_or: r = a | b; break;
+    case trace_op::bit_xor: r = a ^ b; break;
+    }
+}
+
+double percentile(const std::vector<double> &sorted, double p) {
+    auto i = std::size_t(p * double(sorted.size() - 1) + 0.5);
+    return sorted.at(i);
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+    if (argc < 2 || argc > 3) {
+        std::fprintf(stderr, "usage: %s <trace> [repeat]\n", argv[0]);
+        return 2;
+    }
+    int repeat = argc == 3 ? std::max(1, std::atoi(argv[2])) : 1;
+    try {
+        auto records = read_trace(argv[1]);
+        std::mt19937 gen(1);
+        std::vector<std::vector<double>> ns(unsigned(trace_op::bit_xor) + 1);
+        bigint r, s;
+        for (const auto &e : records) {
+            bool shift = e.op == trace_op::lshift || e.op == trace_op::rshift;
+            bigint a(e.a.empty() ? random_limbs(gen, e.la) : e.a, e.apos);
+            bigint b(0);
+            if (!shift)
+                b = bigint(e.b.empty() ? random_limbs(gen, e.lb) : e.b, e.bpos);
+            if (e.op == trace_op::divmod && b == 0) continue;
+            auto t0 = std::chrono::steady_clock::now();
+            for (int i = 0; i < repeat; ++i) run(e, r, s, a, b);
+            auto t1 = std::chrono::steady_clock::now();
+            ns.at(unsigned(e.op))
+                .push_back(std::chrono::duration<double, std::nano>(t1 - t0)
+                               .count() /
+                           repeat);
+        }
+        std::printf("%-8s %10s %12s %12s %12s %12s\n", "op", "count", "p50 ns",
+                    "p90 ns", "p99 ns", "max ns");
+        for (unsigned op = 0; op < ns.size(); ++op) {
+            auto &v = ns.at(op);
+            if (v.empty()) continue;
+            std::sort(v.begin(), v.end());
+            std::printf("%-8s %10zu %12.0f %12.0f %12.0f %12.0f\n",
+                        to_string(trace_op(op)), v.size(), percentile(v, 0.5),
+                        percentile(v, 0.9), percentile(v, 0.99), v.back());
+        }
+    } catch (const std::exception &e) {
+        std::fprintf(stderr, "%s: %s\n", argv[0], e.what());
+        return 1;
+    }
+    return 0;
+}
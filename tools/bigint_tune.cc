@@ -0,0 +1,166 @@
+// MIT License
+//
+// Copyright (c) 2021 wsbky
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Measures the algorithm crossovers of this host and writes them as a
+// thresholds file (see thresholds.hh) or, with --header, as a header for
+// the BIGINT_THRESHOLDS_HEADER build option.
+//
+//   bigint_tune [--header] [output]
+//
+// For every operand size n, the basecase is timed against one level of
+// the faster algorithm over basecase halves; the threshold is the first
+// size from which the faster algorithm wins three sizes in a row. The
+// result goes to standard output when no output file is given.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bigint.hh"
+#include "power_cache.hh"
+
+using namespace extypes;
+
+namespace {
+const int wins_needed = 3;
+
+// Best of several runs of f, each repeated until it takes at least 1 ms.
+double seconds(const std::function<void()> &f) {
+    using clock = std::chrono::steady_clock;
+    int reps = 1;
+    for (;;) {
+        auto t0 = clock::now();
+        for (int i = 0; i < reps; ++i) f();
+        if (clock::now() - t0 >= std::chrono::milliseconds(1)) break;
+        reps *= 2;
+    }
+    double best = 1e300;
+    for (int k = 0; k < 5; ++k) {
+        auto t0 = clock::now();
+        for (int i = 0; i < reps; ++i) f();
+        std::chrono::duration<double> d = clock::now() - t0;
+        best = std::min(best, d.count() / reps);
+    }
+    return best;
+}
+
+// First size n in [lo, hi] from which fast(n) beats slow(n) at
+// wins_needed consecutive sizes, or hi if it never does.
+std::size_t crossover(const char *name, std::size_t lo, std::size_t hi,
+                      const std::function<double(std::size_t, bool)> &time) {
+    std::size_t first = hi, wins = 0;
+    for (auto n = lo; n <= hi; n += std::max<std::size_t>(1, n / 16)) {
+        double slow = time(n, false), fast = time(n, true);
+        std::fprintf(stderr, "%-12s %5zu %10.0f %10.0f ns\n", name, n,
+                     slow * 1e9, fast * 1e9);
+        if (fast < slow) {
+            if (wins++ == 0) first = n;
+            if (wins == wins_needed) return first;
+        } else {
+            wins = 0;
+            first = hi;
+        }
+    }
+    return hi;
+}
+
+std::vector<unsigned> random_limbs(std::mt19937 &gen, std::size_t n) {
+    std::uniform_int_distribution<unsigned> limb(0, 999999999);
+    std::vector<unsigned> r(n);
+    for (auto &e : r) e = limb(gen);
+    r.back() = std::max(r.back(), 1u);
+    return r;
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+    bool header = argc > 1 && std::strcmp(argv[1], "--header") == 0;
+    if (argc > 2 + header) {
+        std::fprintf(stderr, "usage: %s [--header] [output]\n", argv[0]);
+        return 2;
+    }
+    try {
+        std::mt19937 gen(1);
+        auto t = default_thresholds();
+
+        // Multiplication: n x n limbs, schoolbook against one Karatsuba
+        // step (the halves are below the threshold). Karatsuba is used from
+        // the threshold on, so the first winning size is stored as is.
+        t.karatsuba = crossover("karatsuba", 8, 400, [&](std::size_t n,
+                                                         bool fast) {
+            bigint a(random_limbs(gen, n)), b(random_limbs(gen, n)), r;
+            set_thresholds({fast ? n : n + 1, t.binary_split});
+            return seconds([&] { mul(r, a, b); });
+        });
+        set_thresholds(t);
+
+        // Conversion from n binary words: Horner's rule against one split.
+        // Sizes up to the threshold use Horner's rule, so the threshold is
+        // one below the first size at which the split wins.
+        warm_power_cache(32 * 1024);
+        t.binary_split = crossover("binary_split", 2, 1024, [&](std::size_t n,
+                                                                bool fast) {
+            std::vector<unsigned> w(n);
+            for (auto &e : w) e = unsigned(gen());
+            bigint r;
+            set_thresholds({t.karatsuba, fast ? n - 1 : n});
+            return seconds([&] { import_words(r, n, -1, 4, 0, w.data()); });
+        }) - 1;
+        set_thresholds(t);
+
+        if (!header) {
+            if (argc > 1) {
+                save_thresholds(argv[1], t);
+                return 0;
+            }
+            save_thresholds(std::cout, t);
+            if (!std::cout.flush()) {
+                std::fprintf(stderr, "%s: Cannot write output.\n", argv[0]);
+                return 1;
+            }
+            return 0;
+        }
+        std::string out = "// Generated by bigint_tune.\n"
+                          "#define BIGINT_KARATSUBA_THRESHOLD " +
+                          std::to_string(t.karatsuba) +
+                          "\n#define BIGINT_BINARY_SPLIT_THRESHOLD " +
+                          std::to_string(t.binary_split) + "\n";
+        std::FILE *f = argc > 2 ? std::fopen(argv[2], "w") : stdout;
+        if (f == nullptr ||
+            std::fwrite(out.data(), 1, out.size(), f) != out.size() ||
+            (f != stdout && std::fclose(f) != 0)) {
+            std::fprintf(stderr, "%s: Cannot write output.\n", argv[0]);
+            return 1;
+        }
+    } catch (const std::exception &e) {
+        std::fprintf(stderr, "%s: %s\n", argv[0], e.what());
+        return 1;
+    }
+    return 0;
+}